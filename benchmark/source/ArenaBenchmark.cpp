@@ -0,0 +1,89 @@
+#include "Benchmark.h"
+#include "BinarySerializer.h"
+
+#include <string>
+#include <vector>
+
+struct GraphNode
+{
+	int value = 0;
+	std::string label;
+	GraphNode* next = nullptr;
+};
+
+struct Graph
+{
+	GraphNode* head = nullptr;
+};
+
+static void DeleteNodes(GraphNode* head)
+{
+	while (head)
+	{
+		GraphNode* next = head->next;
+		delete head;
+		head = next;
+	}
+}
+
+// Pointer objects of a long list created with new one by one and in an arena
+int main()
+{
+	class_<GraphNode>("GraphNode")
+		.AddProperty("value", &GraphNode::value)
+		.AddProperty("label", &GraphNode::label)
+		.AddProperty("next", &GraphNode::next);
+
+	class_<Graph>("Graph")
+		.AddProperty("head", &Graph::head);
+
+	const size_t nodesCount = 100000U;
+	std::vector<GraphNode> nodes(nodesCount);
+	for (size_t i = 0U; i < nodesCount; ++i)
+	{
+		nodes[i].value = static_cast<int>(i);
+		nodes[i].label = "n" + std::to_string(i);
+		nodes[i].next = i + 1U < nodesCount ? &nodes[i + 1U] : nullptr;
+	}
+	Graph graph;
+	graph.head = &nodes.front();
+
+	BinarySerializer serializer;
+	serializer.Serialize(graph);
+	serializer.SerializePointers();
+	const std::vector<uint8_t> buffer = serializer.GetBuffer();
+
+	const size_t iterations = 10U;
+	MeasureNanoseconds("Deserialize with new", iterations, [&](const size_t)
+	{
+		Graph result;
+		serializer.SetBuffer(buffer.data(), buffer.size());
+		serializer.Deserialize(result);
+		serializer.DeserializePointers();
+		DeleteNodes(result.head);
+	});
+
+	ObjectArena arena;
+	serializer.SetObjectAllocator(&arena);
+	MeasureNanoseconds("Deserialize into arena", iterations, [&](const size_t)
+	{
+		Graph result;
+		serializer.SetBuffer(buffer.data(), buffer.size());
+		serializer.Deserialize(result);
+		serializer.DeserializePointers();
+		arena.Release();
+	});
+
+	Graph result;
+	serializer.SetBuffer(buffer.data(), buffer.size());
+	serializer.Deserialize(result);
+	serializer.DeserializePointers();
+	size_t matchedCount = 0U;
+	for (GraphNode* node = result.head; node && matchedCount < nodesCount; node = node->next)
+	{
+		matchedCount += node->label == nodes[matchedCount].label ? 1U : 0U;
+	}
+	std::cout << "arena round trip: " << (matchedCount == nodesCount ? "ok" : "mismatch") << std::endl;
+
+	return 0;
+}
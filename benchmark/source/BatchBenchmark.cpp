@@ -0,0 +1,107 @@
+#include "Benchmark.h"
+#include "BinarySerializer.h"
+
+#include <string>
+#include <vector>
+
+struct Material
+{
+	float roughness = 0.5f;
+};
+
+struct Entity
+{
+	int id = 0;
+	std::string name;
+	std::vector<float> transform;
+	std::vector<int> children;
+	Material* material = nullptr;
+};
+
+// Independent root objects one by one and as a parallel batch
+int main()
+{
+	class_<Material>("Material")
+		.AddProperty("roughness", &Material::roughness);
+
+	class_<Entity>("Entity")
+		.AddProperty("id", &Entity::id)
+		.AddProperty("name", &Entity::name)
+		.AddProperty("transform", &Entity::transform)
+		.AddProperty("children", &Entity::children)
+		.AddProperty("material", &Entity::material);
+
+	const size_t entitiesCount = 20000U;
+	std::vector<Material> materials(16U);
+	std::vector<Entity> entities(entitiesCount);
+	for (size_t i = 0U; i < entitiesCount; ++i)
+	{
+		Entity& entity = entities[i];
+		entity.id = static_cast<int>(i);
+		entity.name = "Entity_" + std::to_string(i);
+		entity.transform.assign(16U, static_cast<float>(i));
+		entity.children.assign(i % 32U, static_cast<int>(i));
+		entity.material = &materials[i % materials.size()];
+	}
+
+	const size_t iterations = 10U;
+	BinarySerializer sequentialSerializer;
+	BinarySerializer batchSerializer;
+	// Single worker batches fall back to writing in place
+	BinarySerializer singleWorkerSerializer;
+	singleWorkerSerializer.SetWorkersCount(1U);
+
+	MeasureNanoseconds("Serialize one by one", iterations, [&](const size_t)
+	{
+		sequentialSerializer.Clear();
+		for (const auto& entity : entities)
+		{
+			sequentialSerializer.Serialize(entity);
+		}
+	});
+	MeasureNanoseconds("SerializeBatch, " + std::to_string(GetDefaultWorkersCount()) + " workers", iterations, [&](const size_t)
+	{
+		batchSerializer.Clear();
+		batchSerializer.SerializeBatch(entities.data(), entities.size());
+	});
+	MeasureNanoseconds("SerializeBatch, 1 worker", iterations, [&](const size_t)
+	{
+		singleWorkerSerializer.Clear();
+		singleWorkerSerializer.SerializeBatch(entities.data(), entities.size());
+	});
+
+	const std::vector<uint8_t> sequentialBuffer = sequentialSerializer.GetBuffer();
+	const std::vector<uint8_t> batchBuffer = batchSerializer.GetBuffer();
+	const std::vector<uint8_t> singleWorkerBuffer = singleWorkerSerializer.GetBuffer();
+	std::vector<Entity> sequentialEntities(entitiesCount);
+	std::vector<Entity> batchEntities(entitiesCount);
+	std::vector<Entity> singleWorkerEntities(entitiesCount);
+	MeasureNanoseconds("Deserialize one by one", iterations, [&](const size_t)
+	{
+		sequentialSerializer.SetBuffer(sequentialBuffer.data(), sequentialBuffer.size());
+		for (auto& entity : sequentialEntities)
+		{
+			sequentialSerializer.Deserialize(entity);
+		}
+	});
+	MeasureNanoseconds("DeserializeBatch, " + std::to_string(GetDefaultWorkersCount()) + " workers", iterations, [&](const size_t)
+	{
+		batchSerializer.SetBuffer(batchBuffer.data(), batchBuffer.size());
+		batchSerializer.DeserializeBatch(batchEntities.data(), batchEntities.size());
+	});
+	MeasureNanoseconds("DeserializeBatch, 1 worker", iterations, [&](const size_t)
+	{
+		singleWorkerSerializer.SetBuffer(singleWorkerBuffer.data(), singleWorkerBuffer.size());
+		singleWorkerSerializer.DeserializeBatch(singleWorkerEntities.data(), singleWorkerEntities.size());
+	});
+
+	bool isEqual = true;
+	for (size_t i = 0U; i < entitiesCount; ++i)
+	{
+		isEqual = isEqual && batchEntities[i].name == entities[i].name && batchEntities[i].children == entities[i].children;
+		isEqual = isEqual && singleWorkerEntities[i].name == entities[i].name && singleWorkerEntities[i].children == entities[i].children;
+	}
+	std::cout << "batch round trip: " << (isEqual ? "ok" : "mismatch") << std::endl;
+
+	return 0;
+}
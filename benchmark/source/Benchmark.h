@@ -0,0 +1,25 @@
+#ifndef BENCHMARK_INCLUDE
+#define BENCHMARK_INCLUDE
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// Runs func the given number of times and prints the average time per iteration
+template<typename Func>
+double MeasureNanoseconds(const std::string& name, const size_t iterations, Func func)
+{
+	const auto start = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0U; i < iterations; ++i)
+	{
+		func(i);
+	}
+	const auto end = std::chrono::high_resolution_clock::now();
+
+	const double total = std::chrono::duration<double, std::nano>(end - start).count();
+	const double perIteration = total / static_cast<double>(iterations);
+	std::cout << name << ": " << perIteration << " ns" << std::endl;
+	return perIteration;
+}
+
+#endif
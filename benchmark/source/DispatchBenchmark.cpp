@@ -0,0 +1,45 @@
+#include "Benchmark.h"
+#include "ObjectFactory.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Per-element dispatch cost through TypeInfo::ArrayParams. The std::function
+// variant reproduces how the accessors were stored before they became raw
+// function pointers.
+int main()
+{
+	const size_t elementsCount = 1U << 20;
+	const size_t iterations = elementsCount * 16U;
+	const size_t indexMask = elementsCount - 1U;
+
+	std::vector<float> values(elementsCount, 1.0f);
+	void* data = reinterpret_cast<void*>(&values);
+
+	// Accessors are read through heap objects, like serializers read them through TypeInfo
+	const TypeInfo* typeInfo = TypeInfoCollection::GetInstance().GetOrRegisterTypeInfo<std::vector<float>>();
+	using TypeErasedItemGetter = std::function<void*(void*, const size_t)>;
+	const std::unique_ptr<TypeErasedItemGetter> typeErasedGetItem(new TypeErasedItemGetter(typeInfo->arrayParams.getItem));
+
+	uintptr_t checksum = 0U;
+	MeasureNanoseconds("std::function getItem (before)", iterations, [&](const size_t i)
+	{
+		checksum += reinterpret_cast<uintptr_t>((*typeErasedGetItem)(data, i & indexMask));
+	});
+	MeasureNanoseconds("function pointer getItem (after)", iterations, [&](const size_t i)
+	{
+		checksum += reinterpret_cast<uintptr_t>(typeInfo->arrayParams.getItem(data, i & indexMask));
+	});
+	MeasureNanoseconds("VectorItemGetter<float> (statically known)", iterations, [&](const size_t i)
+	{
+		checksum += reinterpret_cast<uintptr_t>(VectorItemGetter<float>(data, i & indexMask));
+	});
+
+	std::cout << "sizeof(std::function accessor): " << sizeof(TypeErasedItemGetter) << " bytes" << std::endl;
+	std::cout << "sizeof(function pointer accessor): " << sizeof(TypeInfo::ArrayParams::ItemGetter) << " bytes" << std::endl;
+	std::cout << "sizeof(TypeInfo): " << sizeof(TypeInfo) << " bytes" << std::endl;
+	std::cout << "checksum: " << checksum << std::endl;
+
+	return 0;
+}
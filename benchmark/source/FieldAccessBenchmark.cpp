@@ -0,0 +1,67 @@
+#include "Benchmark.h"
+#include "BinaryArchiveReader.h"
+
+#include <string>
+#include <vector>
+
+struct Record
+{
+	int id = 0;
+	std::string name;
+	std::vector<float> samples;
+	std::vector<std::string> tags;
+};
+
+// Reading one property of every record compared to decoding whole records
+int main()
+{
+	class_<Record>("Record")
+		.AddProperty("id", &Record::id)
+		.AddProperty("name", &Record::name)
+		.AddProperty("samples", &Record::samples)
+		.AddProperty("tags", &Record::tags);
+
+	const size_t recordsCount = 50000U;
+	BinarySerializer serializer;
+	serializer.SetFieldTablesEnabled(true);
+	for (size_t i = 0U; i < recordsCount; ++i)
+	{
+		Record record;
+		record.id = static_cast<int>(i);
+		record.name = "Record_" + std::to_string(i);
+		record.samples.assign(64U, static_cast<float>(i));
+		record.tags.assign(8U, "tag_" + std::to_string(i % 100U));
+		serializer.Serialize(record);
+	}
+	const std::vector<uint8_t> buffer = serializer.GetBuffer();
+
+	const size_t iterations = 10U;
+	long long decodedSum = 0;
+	MeasureNanoseconds("Deserialize whole records", iterations, [&](const size_t)
+	{
+		serializer.SetInput(buffer.data(), buffer.size());
+		decodedSum = 0;
+		Record record;
+		for (size_t i = 0U; i < recordsCount; ++i)
+		{
+			serializer.Deserialize(record);
+			decodedSum += record.id;
+		}
+	});
+
+	long long readSum = 0;
+	MeasureNanoseconds("Read the id field only", iterations, [&](const size_t)
+	{
+		BinaryArchiveReader reader(buffer.data(), buffer.size());
+		readSum = 0;
+		int id = 0;
+		while (reader.NextObject<Record>())
+		{
+			reader.ReadField("id", id);
+			readSum += id;
+		}
+	});
+	std::cout << "field access: " << (readSum == decodedSum ? "ok" : "mismatch") << std::endl;
+
+	return 0;
+}
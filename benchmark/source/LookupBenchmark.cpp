@@ -0,0 +1,71 @@
+#include "Benchmark.h"
+#include "ObjectFactory.h"
+
+#include <utility>
+#include <vector>
+
+template<size_t N>
+struct BenchmarkObject
+{
+	int value = 0;
+};
+
+template<size_t Offset, size_t... Indices>
+void RegisterObjects(std::index_sequence<Indices...>)
+{
+	const int registered[] = { (class_<BenchmarkObject<Offset + Indices>>("BenchmarkObject" + std::to_string(Offset + Indices)), 0)... };
+	(void)registered;
+}
+
+// Registered in chunks, one huge expansion takes the optimizer very long
+template<size_t... Chunks>
+void RegisterChunks(std::index_sequence<Chunks...>)
+{
+	const int registered[] = { (RegisterObjects<Chunks * 64U>(std::make_index_sequence<64U>()), 0)... };
+	(void)registered;
+}
+
+// Descriptor lookup by class name, as done when objects are instantiated from data
+int main()
+{
+	const size_t objectsCount = 2048U;
+	const size_t iterations = 1U << 20;
+	RegisterChunks(std::make_index_sequence<objectsCount / 64U>());
+
+	auto& factory = ObjectFactory::GetInstance();
+
+	std::vector<std::string> names;
+	for (size_t i = 0U; i < objectsCount; ++i)
+	{
+		names.push_back("BenchmarkObject" + std::to_string((i * 7919U) % objectsCount));
+	}
+
+	uintptr_t checksum = 0U;
+	MeasureNanoseconds("linear search (before)", iterations / 256U, [&](const size_t i)
+	{
+		const auto& name = names[i % objectsCount];
+		const auto& descs = factory.GetObjectDescs();
+		for (const auto& desc : descs)
+		{
+			if (desc.second.GetName() == name)
+			{
+				checksum += desc.first;
+				break;
+			}
+		}
+	});
+	MeasureNanoseconds("GetObjectDesc(const std::string&)", iterations, [&](const size_t i)
+	{
+		checksum += factory.GetObjectDesc(names[i % objectsCount]).GetId();
+	});
+	MeasureNanoseconds("FindObjectDesc(const char*, size_t)", iterations, [&](const size_t i)
+	{
+		const auto& name = names[i % objectsCount];
+		checksum += factory.FindObjectDesc(name.c_str(), name.size())->GetId();
+	});
+
+	std::cout << "registered classes: " << objectsCount << std::endl;
+	std::cout << "checksum: " << checksum << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,93 @@
+#include "Benchmark.h"
+#include "BinarySerializer.h"
+
+#include <string>
+#include <vector>
+
+struct Particle
+{
+	float position[3] = { 0.0f, 0.0f, 0.0f };
+	float velocity[3] = { 0.0f, 0.0f, 0.0f };
+	int id = 0;
+	uint8_t flags = 0U;
+	std::string name;
+};
+
+template<>
+struct StaticFields<Particle>
+{
+	static constexpr auto Get()
+	{
+		return std::make_tuple(
+			MakeStaticField("position", &Particle::position),
+			MakeStaticField("velocity", &Particle::velocity),
+			MakeStaticField("id", &Particle::id),
+			MakeStaticField("flags", &Particle::flags),
+			MakeStaticField("name", &Particle::name));
+	}
+};
+
+// Plan driven serialization compared to code generated from the static field list
+int main()
+{
+	RegisterStaticFields<Particle>("Particle");
+
+	const size_t particlesCount = 100000U;
+	std::vector<Particle> particles(particlesCount);
+	for (size_t i = 0U; i < particlesCount; ++i)
+	{
+		particles[i].id = static_cast<int>(i);
+		particles[i].position[1] = static_cast<float>(i);
+		particles[i].name = "p" + std::to_string(i % 1000U);
+	}
+
+	const size_t iterations = 10U;
+	BinarySerializer dynamicSerializer;
+	BinarySerializer staticSerializer;
+	MeasureNanoseconds("Serialize (plans)", iterations, [&](const size_t)
+	{
+		dynamicSerializer.Clear();
+		for (const auto& particle : particles)
+		{
+			dynamicSerializer.Serialize(particle);
+		}
+	});
+	MeasureNanoseconds("SerializeStatic", iterations, [&](const size_t)
+	{
+		staticSerializer.Clear();
+		for (const auto& particle : particles)
+		{
+			staticSerializer.SerializeStatic(particle);
+		}
+	});
+
+	const std::vector<uint8_t> buffer = staticSerializer.GetBuffer();
+	std::vector<Particle> dynamicParticles(particlesCount);
+	std::vector<Particle> staticParticles(particlesCount);
+	MeasureNanoseconds("Deserialize (plans)", iterations, [&](const size_t)
+	{
+		dynamicSerializer.SetInput(buffer.data(), buffer.size());
+		for (auto& particle : dynamicParticles)
+		{
+			dynamicSerializer.Deserialize(particle);
+		}
+	});
+	MeasureNanoseconds("DeserializeStatic", iterations, [&](const size_t)
+	{
+		staticSerializer.SetInput(buffer.data(), buffer.size());
+		for (auto& particle : staticParticles)
+		{
+			staticSerializer.DeserializeStatic(particle);
+		}
+	});
+
+	const bool isSameOutput = dynamicSerializer.GetBuffer() == buffer;
+	bool isEqual = true;
+	for (size_t i = 0U; i < particlesCount; ++i)
+	{
+		isEqual = isEqual && staticParticles[i].id == dynamicParticles[i].id && staticParticles[i].name == particles[i].name;
+	}
+	std::cout << "static fields: " << (isSameOutput && isEqual ? "ok" : "mismatch") << std::endl;
+
+	return 0;
+}
@@ -66,12 +66,9 @@ void JsonSerializer::DeserializePointers()
 				const auto& typeInfo = typeInfoCollection.GetTypeInfo(typeName);
 				auto actualData = findIt->second;
 
-				void* valueBuffer = nullptr;
-				size_t bufferSize = 0U;
-
 				auto temp = m_currentValue;
 				m_currentValue = &value;
-				typeInfo->createDefaultValue(valueBuffer, bufferSize);
+				void* valueBuffer = typeInfo->CreateValue(m_objectAllocator);
 
 				DeserializeByType(*typeInfo, valueBuffer);
 
@@ -88,71 +85,113 @@ void JsonSerializer::DeserializePointers()
 
 void JsonSerializer::SerializeInternal(const ObjectDesc& objectDesc, void* object)
 {
-	Json::Value objectValue;
-	const auto& properties = objectDesc.GetProperties();
+	auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const auto planIndex = plans.GetPlanIndex(objectDesc.GetId());
 
 	auto currentRoot = m_currentValue;
-	for (const auto prop : properties)
-	{
-		const auto& typeInfo = prop.second->GetTypeInfo();
-		void* data = prop.second->GetValue(object);
 
-		Json::Value propertyValue;
-		m_currentValue = &propertyValue;
-
-		SerializeByType(typeInfo, data);
+	Json::Value objectValue;
+	m_currentValue = &objectValue;
+	SerializePlan(planIndex, object);
 
-		objectValue[prop.first] = propertyValue;
-	}
 	(*currentRoot)[objectDesc.GetName()] = objectValue;
 	m_currentValue = currentRoot;
 }
 
 void JsonSerializer::DeserializeInternal(const ObjectDesc& objectDesc, void* object)
 {
+	auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const auto planIndex = plans.GetPlanIndex(objectDesc.GetId());
+
 	auto currentRoot = m_currentValue;
+
 	Json::Value child = (*currentRoot)[objectDesc.GetName()];
+	m_currentValue = &child;
+	DeserializePlan(planIndex, object);
 
-	const auto& properties = objectDesc.GetProperties();
+	m_currentValue = currentRoot;
+}
+
+void JsonSerializer::SerializePlan(const size_t planIndex, void* object)
+{
+	const auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const auto& plan = plans.GetPlan(planIndex);
+	const SerializationStep* steps = plans.GetSteps(plan);
 
-	for (const auto prop : properties)
+	auto objectValue = m_currentValue;
+	for (size_t i = 0U; i < plan.stepsCount; ++i)
 	{
-		const auto& typeInfo = prop.second->GetTypeInfo();
-		void* data = prop.second->GetValue(object);
+		const auto& step = steps[i];
+		TempStack::Scope tempScope(m_tempStack);
+		void* data = step.GetData(object, m_tempStack);
 
-		const bool isMember = child.isMember(prop.first);
+		Json::Value propertyValue;
+		m_currentValue = &propertyValue;
+
+		SerializeByType(*step.typeInfo, data, step.nestedPlanIndex);
+
+		(*objectValue)[step.property->GetName()] = propertyValue;
+	}
+	m_currentValue = objectValue;
+}
+
+void JsonSerializer::DeserializePlan(const size_t planIndex, void* object)
+{
+	const auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const auto& plan = plans.GetPlan(planIndex);
+	const SerializationStep* steps = plans.GetSteps(plan);
+
+	auto child = m_currentValue;
+	for (size_t i = 0U; i < plan.stepsCount; ++i)
+	{
+		const auto& step = steps[i];
+		const auto& name = step.property->GetName();
+
+		const bool isMember = child->isMember(name);
 		if (isMember)
 		{
-			Json::Value propertyValue = child[prop.first];
+			TempStack::Scope tempScope(m_tempStack);
+			void* data = step.GetData(object, m_tempStack);
+
+			Json::Value propertyValue = (*child)[name];
 			m_currentValue = &propertyValue;
 
-			DeserializeByType(typeInfo, data);
+			DeserializeByType(*step.typeInfo, data, step.nestedPlanIndex);
 
-			prop.second->SetValue(object, data);
+			// Direct fields were written in place, only accessors need to be called
+			if (!step.IsDirectField())
+			{
+				step.MoveValue(object, data);
+			}
 		}
 	}
-	m_currentValue = currentRoot;
+	m_currentValue = child;
 }
 
-void JsonSerializer::SerializeByType(const TypeInfo& typeInfo, void* data)
+void JsonSerializer::SerializeByType(const TypeInfo& typeInfo, void* data, size_t planIndex)
 {
 	switch (typeInfo.type)
 	{
 	case TypeInfo::Fundamental:
 	case TypeInfo::Enum:
 	{
-		const auto typeIndex = typeInfo.fundamentalTypeParams.typeIndex;
+		const auto& codec = GetBasicTypeCodec(typeInfo);
+		BasicValue value;
+		codec.load(data, value);
 
-		switch (typeIndex)
+		switch (codec.category)
 		{
-		case BT_INT_32:
-			*m_currentValue = *(reinterpret_cast<int*>(data));
+		case BasicTypeCategory::Signed:
+			*m_currentValue = static_cast<Json::Int64>(value.signedValue);
 			break;
-		case BT_FLOAT:
-			*m_currentValue = *(reinterpret_cast<float*>(data));
+		case BasicTypeCategory::Unsigned:
+			*m_currentValue = static_cast<Json::UInt64>(value.unsignedValue);
 			break;
-		case BT_DOUBLE:
-			*m_currentValue = *(reinterpret_cast<double*>(data));
+		case BasicTypeCategory::Floating:
+			*m_currentValue = value.floatingValue;
+			break;
+		case BasicTypeCategory::Bool:
+			*m_currentValue = value.boolValue;
 			break;
 		default:
 			*m_currentValue = "none";
@@ -162,30 +201,20 @@ void JsonSerializer::SerializeByType(const TypeInfo& typeInfo, void* data)
 	break;
 	case TypeInfo::Class:
 	{
-		auto& factoryInstance = ObjectFactory::GetInstance();
-		const auto id = typeInfo.GetObjectDescId();
-
-		const auto& childObjectDesc = factoryInstance.GetObjectDesc(id);
+		if (planIndex == SerializationPlans::InvalidIndex)
+		{
+			auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+			planIndex = plans.GetPlanIndex(typeInfo.GetObjectDescId());
+		}
 
 		auto temp = m_currentValue;
 
 		Json::Value objectValue;
-		const auto& childProperties = childObjectDesc.GetProperties();
-
-		for (const auto childProp : childProperties)
-		{
-			const auto& propertyTypeInfo = childProp.second->GetTypeInfo();
-			void* childData = childProp.second->GetValue(data);
-
-			Json::Value propertyValue;
-			m_currentValue = &propertyValue;
-
-			SerializeByType(propertyTypeInfo, childData);
-
-			objectValue[childProp.first] = propertyValue;
-		}
+		m_currentValue = &objectValue;
+		SerializePlan(planIndex, data);
 
 		(*temp) = objectValue;
+		m_currentValue = temp;
 	}
 	break;
 	case TypeInfo::String:
@@ -235,7 +264,7 @@ void JsonSerializer::SerializeByType(const TypeInfo& typeInfo, void* data)
 			Json::Value itemValue;
 			m_currentValue = &itemValue;
 			void* currentDataAddress = typeInfo.arrayParams.getItem(data, i);
-			SerializeByType(*elementTypeInfo, currentDataAddress);
+			SerializeByType(*elementTypeInfo, currentDataAddress, planIndex);
 			temp->append(itemValue);
 		}
 		m_currentValue = temp;
@@ -243,7 +272,9 @@ void JsonSerializer::SerializeByType(const TypeInfo& typeInfo, void* data)
 	break;
 	case TypeInfo::Map:
 	{
-		auto it = typeInfo.mapParams.getIterator(data);
+		TypeInfo::MapParams::IteratorStorage iteratorStorage;
+		typeInfo.mapParams.initIterator(data, iteratorStorage);
+		void* it = iteratorStorage.data;
 		auto temp = m_currentValue;
 		while (typeInfo.mapParams.isIteratorValid(it, data))
 		{
@@ -273,57 +304,45 @@ void JsonSerializer::SerializeByType(const TypeInfo& typeInfo, void* data)
 	}
 }
 
-void JsonSerializer::DeserializeByType(const TypeInfo& typeInfo, void* data)
+void JsonSerializer::DeserializeByType(const TypeInfo& typeInfo, void* data, size_t planIndex)
 {
 	switch (typeInfo.type)
 	{
 	case TypeInfo::Fundamental:
 	case TypeInfo::Enum:
 	{
-		const auto typeIndex = typeInfo.fundamentalTypeParams.typeIndex;
+		const auto& codec = GetBasicTypeCodec(typeInfo);
+		BasicValue value;
 
-		switch (typeIndex)
+		switch (codec.category)
 		{
-		case BT_INT_32:
-			*(reinterpret_cast<int*>(data)) = m_currentValue->asInt();
+		case BasicTypeCategory::Signed:
+			value.signedValue = m_currentValue->asInt64();
+			break;
+		case BasicTypeCategory::Unsigned:
+			value.unsignedValue = m_currentValue->asUInt64();
 			break;
-		case BT_FLOAT:
-			*(reinterpret_cast<float*>(data)) = m_currentValue->asFloat();
+		case BasicTypeCategory::Floating:
+			value.floatingValue = m_currentValue->asDouble();
 			break;
-		case BT_DOUBLE:
+		case BasicTypeCategory::Bool:
+			value.boolValue = m_currentValue->asBool();
 			break;
 		default:
 			break;
 		}
+
+		codec.store(data, value);
 	}
 	break;
 	case TypeInfo::Class:
 	{
-		auto& factoryInstance = ObjectFactory::GetInstance();
-		const auto id = typeInfo.GetObjectDescId();
-
-		const auto& childObjectDesc = factoryInstance.GetObjectDesc(id);
-
-		const auto& childProperties = childObjectDesc.GetProperties();
-
-		auto child = m_currentValue;
-
-		for (const auto childProp : childProperties)
+		if (planIndex == SerializationPlans::InvalidIndex)
 		{
-			const auto& childTypeInfo = childProp.second->GetTypeInfo();
-			void* childData = childProp.second->GetValue(data);
-
-			const bool isMember = (*child).isMember(childProp.first);
-			if (isMember)
-			{
-				Json::Value propertyValue = (*child)[childProp.first];
-				m_currentValue = &propertyValue;
-
-				DeserializeByType(childTypeInfo, childData);
-
-				childProp.second->SetValue(data, childData);
-			}
+			auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+			planIndex = plans.GetPlanIndex(typeInfo.GetObjectDescId());
 		}
+		DeserializePlan(planIndex, data);
 	}
 	break;
 	case TypeInfo::String:
@@ -351,11 +370,11 @@ void JsonSerializer::DeserializeByType(const TypeInfo& typeInfo, void* data)
 		auto temp = m_currentValue;
 		for (size_t i = 0U; i < elementsCount; ++i)
 		{
-			Json::Value itemValue = (*temp)[i];
+			Json::Value itemValue = (*temp)[static_cast<Json::ArrayIndex>(i)];
 			m_currentValue = &itemValue;
 
 			void* currentDataAddress = typeInfo.arrayParams.getItem(data, i);
-			DeserializeByType(*underlyingTypeInfo, reinterpret_cast<void*>(currentDataAddress));
+			DeserializeByType(*underlyingTypeInfo, reinterpret_cast<void*>(currentDataAddress), planIndex);
 		}
 		m_currentValue = temp;
 	}
@@ -364,33 +383,29 @@ void JsonSerializer::DeserializeByType(const TypeInfo& typeInfo, void* data)
 	{
 		const auto elementsCount = m_currentValue->size();
 
-		void* keyBuffer = nullptr;
-		void* valueBuffer = nullptr;
-		size_t keyBufferSize = 0U;
-		size_t valueBufferSize = 0U;
+		const TypeInfo& keyTypeInfo = *typeInfo.mapParams.keyTypeInfo;
+		const TypeInfo& valueTypeInfo = *typeInfo.mapParams.valueTypeInfo;
 
-		typeInfo.mapParams.keyTypeInfo->createDefaultValue(keyBuffer, keyBufferSize);
-		typeInfo.mapParams.valueTypeInfo->createDefaultValue(valueBuffer, valueBufferSize);
+		// Values are read straight into the map nodes, so pointer slots refer to the map
+		typeInfo.mapParams.clear(data);
 
-		auto& keyContainer = ObjectFactory::GetInstance().GetTempContainer(0U);
-		auto& valueContainer = ObjectFactory::GetInstance().GetTempContainer(1U);
+		TempStack::Scope scope(m_tempStack);
+		TempContainer& keyContainer = m_tempStack.Push();
 
 		auto temp = m_currentValue;
 		for (size_t i = 0U; i < elementsCount; ++i)
 		{
-			Json::Value itemValue = (*temp)[i];
+			Json::Value itemValue = (*temp)[static_cast<Json::ArrayIndex>(i)];
 
 			m_currentValue = &itemValue["key"];
-			DeserializeByType(*typeInfo.mapParams.keyTypeInfo, keyBuffer);
+			void* keyBuffer = keyContainer.Construct(keyTypeInfo.size, keyTypeInfo.alignment,
+				keyTypeInfo.constructValue, keyTypeInfo.destructValue);
+			DeserializeByType(keyTypeInfo, keyBuffer);
 
 			m_currentValue = &itemValue["value"];
-			DeserializeByType(*typeInfo.mapParams.valueTypeInfo, valueBuffer);
-
-			typeInfo.mapParams.setKeyValue(data, keyBuffer, valueBuffer);
+			DeserializeByType(valueTypeInfo, typeInfo.mapParams.emplaceValue(data, keyBuffer));
 		}
 		m_currentValue = temp;
-		typeInfo.mapParams.keyTypeInfo->deleteValue(keyBuffer);
-		typeInfo.mapParams.valueTypeInfo->deleteValue(valueBuffer);
 	}
 	break;
 	default:
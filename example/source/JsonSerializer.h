@@ -2,6 +2,7 @@
 #define JSON_SERIALIZER_INCLUDE
 
 #include "Serializer.h"
+#include "BasicTypeCodec.h"
 
 #include <json/json.h>
 
@@ -25,8 +26,11 @@ protected:
 	void SerializeInternal(const ObjectDesc& objectDesc, void* object) override final;
 	void DeserializeInternal(const ObjectDesc& objectDesc, void* object) override final;
 
-	void SerializeByType(const TypeInfo& typeInfo, void* data);
-	void DeserializeByType(const TypeInfo& typeInfo, void* data);
+	void SerializePlan(const size_t planIndex, void* object);
+	void DeserializePlan(const size_t planIndex, void* object);
+
+	void SerializeByType(const TypeInfo& typeInfo, void* data, size_t planIndex = SerializationPlans::InvalidIndex);
+	void DeserializeByType(const TypeInfo& typeInfo, void* data, size_t planIndex = SerializationPlans::InvalidIndex);
 };
 
 #endif
\ No newline at end of file
@@ -1,6 +1,14 @@
 #include "JsonSerializer.h"
+#include "BinarySerializer.h"
+#include "JsonStreamSerializer.h"
+#include "BinaryArchiveReader.h"
+#include "MappedFile.h"
 
 #include <iostream>
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+#include <iterator>
 
 template<typename T>
 struct Getter
@@ -66,7 +74,7 @@ struct TestStruct
 	int someArray[5] = { 1, 4, 5, 8, 9 };
 	int someMatrix[3][3] = { {1, 2, 3}, {3, 3, 3}, {6, 6, 6} };
 	std::vector<int> someVector;
-	std::array<int, 3> someStaticArray;
+	std::array<int, 3> someStaticArray = {};
 	std::map<std::string, float> someMap;
 	Vec3 vec3;
 	Vec* vec = nullptr;
@@ -90,6 +98,152 @@ struct TestStruct3
 	Vec2* vec2 = nullptr;
 };
 
+// Refers to its own type, plans of such objects are compiled once
+struct Node
+{
+	int value = 0;
+	std::vector<Node> children;
+};
+
+static bool operator==(const Node& left, const Node& right)
+{
+	return left.value == right.value && left.children == right.children;
+}
+
+// Several bases, the second one is not at the start of the object
+struct Named
+{
+	std::string name;
+	virtual ~Named() {}
+};
+
+struct Weighted
+{
+	float weight = 0.0f;
+};
+
+struct Item : Named, Weighted
+{
+	int count = 0;
+};
+
+// Both bases share one Entity subobject
+struct Entity
+{
+	int id = 0;
+	virtual ~Entity() {}
+};
+
+struct Visible : virtual Entity
+{
+	bool visible = false;
+};
+
+struct Movable : virtual Entity
+{
+	float speed = 0.0f;
+};
+
+struct Actor : Visible, Movable
+{
+	std::string tag;
+};
+
+// Views refer to the archive memory instead of owning copies
+struct Mesh
+{
+	StringView name;
+	ArchiveView<float> positions;
+};
+
+static bool operator==(const Item& left, const Item& right)
+{
+	return left.name == right.name && left.weight == right.weight && left.count == right.count;
+}
+
+static bool operator==(const Actor& left, const Actor& right)
+{
+	return left.id == right.id && left.visible == right.visible && left.speed == right.speed && left.tag == right.tag;
+}
+
+struct PointerList
+{
+	std::vector<Vec3*> points;
+	std::map<std::string, int> counts;
+	std::vector<int> emptyValues;
+};
+
+static int failedChecks = 0;
+
+static void Check(const bool condition, const std::string& description)
+{
+	if (!condition)
+	{
+		std::cout << "Check failed: " << description << std::endl;
+		++failedChecks;
+	}
+}
+
+static bool IsEqual(const Vec3& left, const Vec3& right)
+{
+	return left.x == right.x && left.y == right.y && left.z == right.z;
+}
+
+static bool IsEqual(const Vec* left, const Vec* right)
+{
+	const Vec3* left3 = dynamic_cast<const Vec3*>(left);
+	const Vec3* right3 = dynamic_cast<const Vec3*>(right);
+	return left3 && right3 ? IsEqual(*left3, *right3) : left == right;
+}
+
+static void CheckTestStruct(const TestStruct& actual, const TestStruct& expected, const std::string& name)
+{
+	Check(actual.intValue == expected.intValue, name + " intValue");
+	Check(actual.floatValue == expected.floatValue, name + " floatValue");
+	Check(std::equal(std::begin(actual.someArray), std::end(actual.someArray), std::begin(expected.someArray)), name + " someArray");
+	Check(std::equal(&actual.someMatrix[0][0], &actual.someMatrix[0][0] + 9, &expected.someMatrix[0][0]), name + " someMatrix");
+	Check(actual.someVector == expected.someVector, name + " someVector");
+	Check(actual.someStaticArray == expected.someStaticArray, name + " someStaticArray");
+	Check(actual.someMap == expected.someMap, name + " someMap");
+	Check(IsEqual(actual.vec3, expected.vec3), name + " vec3");
+	Check(actual.vec != expected.vec && IsEqual(actual.vec, expected.vec), name + " vec");
+	Check(actual.someEnum == expected.someEnum, name + " someEnum");
+	Check(actual.someString == expected.someString, name + " someString");
+	Check(IsEqual(actual.GetVec3(), expected.GetVec3()), name + " Vec3Accessor");
+}
+
+// Pointers to one object must stay shared after a round-trip
+static void CheckPointers(const TestStruct& object, const TestStruct2& object2, const TestStruct3& object3, const std::string& name)
+{
+	Check(object2.intVal == 999 && object3.floatVal == 444.3f, name + " pointer owners");
+	Check(object2.vec2 != nullptr && object2.vec2 == object.vec && object3.vec2 == object.vec, name + " shared pointers");
+}
+
+static void CheckPointerList(const PointerList& actual, const PointerList& expected, const std::string& name)
+{
+	bool isEqual = actual.points.size() == expected.points.size();
+	for (size_t i = 0U; isEqual && i < actual.points.size(); ++i)
+	{
+		isEqual = actual.points[i] != nullptr && IsEqual(*actual.points[i], *expected.points[i]);
+	}
+	Check(isEqual, name + " vector of pointers");
+	Check(actual.points.size() == 3U && actual.points[0] == actual.points[2], name + " shared vector elements");
+	Check(actual.counts == expected.counts, name + " map");
+	Check(actual.emptyValues.empty(), name + " empty array");
+}
+
+template<typename SerializerType, typename ObjectType>
+double MeasureSerialization(SerializerType& serializer, const ObjectType& object, const size_t iterations)
+{
+	const auto start = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0U; i < iterations; ++i)
+	{
+		serializer.Serialize(object);
+	}
+	const auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
 int main()
 {
 	class_<Vec>("Vec");
@@ -140,6 +294,50 @@ int main()
 		.AddProperty("c", &DerivedClass::c)
 		;
 
+	class_<PointerList>("PointerList")
+		.AddProperty("points", &PointerList::points)
+		.AddProperty("counts", &PointerList::counts)
+		.AddProperty("emptyValues", &PointerList::emptyValues)
+		;
+
+	class_<Node>("Node")
+		.AddProperty("value", &Node::value)
+		.AddProperty("children", &Node::children)
+		;
+
+	class_<Named>("Named")
+		.AddProperty("name", &Named::name)
+		;
+
+	class_<Weighted>("Weighted")
+		.AddProperty("weight", &Weighted::weight)
+		;
+
+	class_<Item, Named, Weighted>("Item")
+		.AddProperty("count", &Item::count)
+		;
+
+	class_<Entity>("Entity")
+		.AddProperty("id", &Entity::id)
+		;
+
+	class_<Visible, Entity>("Visible")
+		.AddProperty("visible", &Visible::visible)
+		;
+
+	class_<Movable, Entity>("Movable")
+		.AddProperty("speed", &Movable::speed)
+		;
+
+	class_<Actor, Visible, Movable>("Actor")
+		.AddProperty("tag", &Actor::tag)
+		;
+
+	class_<Mesh>("Mesh")
+		.AddProperty("name", &Mesh::name)
+		.AddProperty("positions", &Mesh::positions)
+		;
+
 	Vec3* vec3 = new Vec3();
 	vec3->x = 555.7f;
 	vec3->y = 6.2f;
@@ -169,6 +367,14 @@ int main()
 	objectOfTestStruct3.vec2 = vec3;
 	objectOfTestStruct3.floatVal = 444.3f;
 
+	Vec3 points[2];
+	points[0].x = 1.0f;
+	points[1].y = 2.0f;
+	PointerList pointerList;
+	pointerList.points = { &points[0], &points[1], &points[0] };
+	pointerList.counts["first"] = 1;
+	pointerList.counts["second"] = 2;
+
 	JsonSerializer serializer("test.json");
  	serializer.Serialize(objectToSerialize_1);
 	serializer.Serialize(objectOfTestStruct2);
@@ -180,10 +386,201 @@ int main()
 	serializer.Deserialize(objectDesOfTestStruct2);
 	serializer.Deserialize(objectDesOfTestStruct3);
 	serializer.DeserializePointers();
+	CheckTestStruct(objectToDeserialize, objectToSerialize_1, "json");
+	CheckPointers(objectToDeserialize, objectDesOfTestStruct2, objectDesOfTestStruct3, "json");
 
 	serializer.Clear();
 
+	BinarySerializer binarySerializer;
+	binarySerializer.Serialize(objectToSerialize_1);
+	binarySerializer.Serialize(objectOfTestStruct2);
+	binarySerializer.Serialize(objectOfTestStruct3);
+	binarySerializer.Serialize(pointerList);
+	binarySerializer.SerializePointers();
+
+	// Stale elements of reused vectors must be dropped
+	TestStruct binaryObjectToDeserialize;
+	binaryObjectToDeserialize.someVector = { 1, 2, 3 };
+	TestStruct2 binaryObjectOfTestStruct2;
+	TestStruct3 binaryObjectOfTestStruct3;
+	PointerList binaryPointerList;
+	binaryPointerList.emptyValues = { 4, 5 };
+	binarySerializer.Deserialize(binaryObjectToDeserialize);
+	binarySerializer.Deserialize(binaryObjectOfTestStruct2);
+	binarySerializer.Deserialize(binaryObjectOfTestStruct3);
+	binarySerializer.Deserialize(binaryPointerList);
+	binarySerializer.DeserializePointers();
+	CheckTestStruct(binaryObjectToDeserialize, objectToSerialize_1, "binary");
+	CheckPointers(binaryObjectToDeserialize, binaryObjectOfTestStruct2, binaryObjectOfTestStruct3, "binary");
+	CheckPointerList(binaryPointerList, pointerList, "binary");
+
+	std::string streamOutput;
+	JsonStringSink streamSink(streamOutput);
+	JsonStreamSerializer streamSerializer(streamSink);
+	streamSerializer.Serialize(objectToSerialize_1);
+	streamSerializer.Serialize(objectOfTestStruct2);
+	streamSerializer.Serialize(objectOfTestStruct3);
+	streamSerializer.Serialize(pointerList);
+	streamSerializer.SerializePointers();
+	streamSerializer.Finish();
+	std::cout << streamOutput << std::endl;
+
+	TestStruct streamObjectToDeserialize;
+	streamObjectToDeserialize.someVector = { 1, 2, 3 };
+	TestStruct2 streamObjectOfTestStruct2;
+	TestStruct3 streamObjectOfTestStruct3;
+	PointerList streamPointerList;
+	streamPointerList.emptyValues = { 4, 5 };
+	JsonStreamSerializer streamDeserializer(streamOutput.data(), streamOutput.size());
+	streamDeserializer.Deserialize(streamObjectToDeserialize);
+	streamDeserializer.Deserialize(streamObjectOfTestStruct2);
+	streamDeserializer.Deserialize(streamObjectOfTestStruct3);
+	streamDeserializer.Deserialize(streamPointerList);
+	streamDeserializer.DeserializePointers();
+	CheckTestStruct(streamObjectToDeserialize, objectToSerialize_1, "stream json");
+	CheckPointers(streamObjectToDeserialize, streamObjectOfTestStruct2, streamObjectOfTestStruct3, "stream json");
+	CheckPointerList(streamPointerList, pointerList, "stream json");
+
+	Node tree;
+	tree.value = 1;
+	tree.children.resize(2);
+	tree.children[0].value = 2;
+	tree.children[1].value = 3;
+	tree.children[1].children.resize(1);
+	tree.children[1].children[0].value = 4;
+
+	BinarySerializer treeSerializer;
+	treeSerializer.Serialize(tree);
+	Node binaryTree;
+	treeSerializer.Deserialize(binaryTree);
+	Check(binaryTree == tree, "binary Node tree");
+
+	std::string treeOutput;
+	{
+		JsonStringSink treeSink(treeOutput);
+		JsonStreamSerializer treeStreamSerializer(treeSink);
+		treeStreamSerializer.Serialize(tree);
+		treeStreamSerializer.Finish();
+	}
+	Node streamTree;
+	JsonStreamSerializer treeStreamDeserializer(treeOutput.data(), treeOutput.size());
+	treeStreamDeserializer.Deserialize(streamTree);
+	Check(streamTree == tree, "stream json Node tree");
+
+	// Root objects with field tables end where the pointers section starts
+	BinarySerializer tableSerializer;
+	tableSerializer.SetFieldTablesEnabled(true);
+	tableSerializer.Serialize(objectOfTestStruct2);
+	tableSerializer.Serialize(objectOfTestStruct2);
+	tableSerializer.SerializePointers();
+
+	BinaryArchiveReader archiveReader(tableSerializer.GetBuffer().data(), tableSerializer.GetBuffer().size());
+	size_t archiveObjectsCount = 0U;
+	while (archiveReader.NextObject<TestStruct2>())
+	{
+		int intValue = 0;
+		float wrongType = 0.0f;
+		Check(archiveReader.ReadField("intValue", intValue) && intValue == 999, "archive reader field");
+		Check(!archiveReader.ReadField("intValue", wrongType), "archive reader field type");
+		++archiveObjectsCount;
+	}
+	Check(archiveObjectsCount == 2U, "archive reader objects count");
+
+	TestStruct2 tableObjects[2];
+	tableSerializer.Deserialize(tableObjects[0]);
+	tableSerializer.Deserialize(tableObjects[1]);
+	tableSerializer.DeserializePointers();
+	Check(tableObjects[0].vec2 != nullptr && tableObjects[0].vec2 == tableObjects[1].vec2, "field tables pointers");
+
+	Item item;
+	item.name = "crate";
+	item.weight = 12.5f;
+	item.count = 3;
+
+	Actor actor;
+	actor.id = 42;
+	actor.visible = true;
+	actor.speed = 1.5f;
+	actor.tag = "player";
+
+	BinarySerializer inheritanceSerializer;
+	inheritanceSerializer.Serialize(item);
+	inheritanceSerializer.Serialize(actor);
+	Item binaryItem;
+	Actor binaryActor;
+	inheritanceSerializer.Deserialize(binaryItem);
+	inheritanceSerializer.Deserialize(binaryActor);
+	Check(binaryItem == item, "binary multiple inheritance");
+	Check(binaryActor == actor, "binary virtual inheritance");
+
+	std::string inheritanceOutput;
+	{
+		JsonStringSink inheritanceSink(inheritanceOutput);
+		JsonStreamSerializer inheritanceStreamSerializer(inheritanceSink);
+		inheritanceStreamSerializer.Serialize(item);
+		inheritanceStreamSerializer.Serialize(actor);
+		inheritanceStreamSerializer.Finish();
+	}
+	Item streamItem;
+	Actor streamActor;
+	JsonStreamSerializer inheritanceStreamDeserializer(inheritanceOutput.data(), inheritanceOutput.size());
+	inheritanceStreamDeserializer.Deserialize(streamItem);
+	inheritanceStreamDeserializer.Deserialize(streamActor);
+	Check(streamItem == item, "stream json multiple inheritance");
+	Check(streamActor == actor, "stream json virtual inheritance");
+
+	const char meshName[] = "quad";
+	const float meshPositions[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+	Mesh mesh;
+	mesh.name = StringView(meshName, sizeof(meshName) - 1U);
+	mesh.positions = ArchiveView<float>(meshPositions, sizeof(meshPositions) / sizeof(float));
+
+	BinarySerializer meshSerializer;
+	meshSerializer.Serialize(mesh);
+	{
+		std::ofstream meshFile("mesh.bin", std::ios::binary);
+		const auto& meshBuffer = meshSerializer.GetBuffer();
+		meshFile.write(reinterpret_cast<const char*>(meshBuffer.data()), meshBuffer.size());
+	}
+
+	MappedFile mappedMesh;
+	Check(mappedMesh.Open("mesh.bin"), "mapped file open");
+	if (mappedMesh.IsOpen())
+	{
+		BinarySerializer mappedSerializer;
+		mappedSerializer.SetInput(mappedMesh.GetData(), mappedMesh.GetSize());
+		Mesh mappedMeshObject;
+		mappedSerializer.Deserialize(mappedMeshObject);
+
+		const char* mappedBegin = reinterpret_cast<const char*>(mappedMesh.GetData());
+		const char* mappedEnd = mappedBegin + mappedMesh.GetSize();
+		const char* nameData = reinterpret_cast<const char*>(mappedMeshObject.name.GetData());
+		Check(nameData >= mappedBegin && nameData < mappedEnd, "archive view points into the mapped file");
+
+		bool isEqual = mappedMeshObject.name.GetSize() == sizeof(meshName) - 1U;
+		for (size_t i = 0U; isEqual && i < mappedMeshObject.name.GetSize(); ++i)
+		{
+			isEqual = mappedMeshObject.name[i] == meshName[i];
+		}
+		isEqual = isEqual && mappedMeshObject.positions.GetSize() == mesh.positions.GetSize();
+		for (size_t i = 0U; isEqual && i < mappedMeshObject.positions.GetSize(); ++i)
+		{
+			isEqual = mappedMeshObject.positions[i] == meshPositions[i];
+		}
+		Check(isEqual, "archive view from mapped file");
+	}
+
+	const size_t iterations = 10000U;
+	JsonSerializer jsonThroughputSerializer("throughput.json");
+	BinarySerializer binaryThroughputSerializer;
+	std::string streamThroughputOutput;
+	JsonStringSink streamThroughputSink(streamThroughputOutput);
+	JsonStreamSerializer streamThroughputSerializer(streamThroughputSink);
+	std::cout << "JsonSerializer: " << MeasureSerialization(jsonThroughputSerializer, objectToSerialize_1, iterations) << " ms" << std::endl;
+	std::cout << "BinarySerializer: " << MeasureSerialization(binaryThroughputSerializer, objectToSerialize_1, iterations) << " ms" << std::endl;
+	std::cout << "JsonStreamSerializer: " << MeasureSerialization(streamThroughputSerializer, objectToSerialize_1, iterations) << " ms" << std::endl;
+
 	auto r = Getter<int>::Get();
 
-    return 0;
+    return failedChecks == 0 ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef ARCHIVE_VIEW_INCLUDE
+#define ARCHIVE_VIEW_INCLUDE
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// Untyped part of ArchiveView, serializers fill it without knowing the element type
+class ArchiveViewData
+{
+public:
+	const void* GetData() const { return m_data; }
+	size_t GetBytesCount() const { return m_bytesCount; }
+
+	void Reset(const void* data, const size_t bytesCount)
+	{
+		m_data = reinterpret_cast<const char*>(data);
+		m_bytesCount = bytesCount;
+	}
+
+protected:
+	const char* m_data = nullptr;
+	size_t m_bytesCount = 0U;
+};
+
+// Read-only range of values which refers to memory it does not own. BinarySerializer
+// points it straight into the archive instead of copying, so it stays valid only while
+// the archive memory does. It is stored like a string or a vector of T.
+// Elements in an archive are not aligned, so they are read by value.
+template<typename T>
+class ArchiveView : public ArchiveViewData
+{
+	static_assert(std::is_trivially_copyable<T>::value, "ArchiveView elements must be trivially copyable");
+
+public:
+	using ValueType = T;
+
+	ArchiveView() = default;
+	ArchiveView(const T* data, const size_t size)
+	{
+		Reset(data, size * sizeof(T));
+	}
+
+	size_t GetSize() const { return m_bytesCount / sizeof(T); }
+	bool IsEmpty() const { return m_bytesCount == 0U; }
+
+	T operator[](const size_t index) const
+	{
+		T value;
+		std::memcpy(&value, m_data + index * sizeof(T), sizeof(T));
+		return value;
+	}
+};
+
+using StringView = ArchiveView<char>;
+
+#endif
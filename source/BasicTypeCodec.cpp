@@ -0,0 +1,130 @@
+#include "BasicTypeCodec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+template<typename T>
+constexpr BasicTypeCategory GetBasicTypeCategory()
+{
+	return std::is_same<T, bool>::value ? BasicTypeCategory::Bool
+		: std::is_floating_point<T>::value ? BasicTypeCategory::Floating
+		: std::is_signed<T>::value ? BasicTypeCategory::Signed
+		: BasicTypeCategory::Unsigned;
+}
+
+template<typename T, typename ValueType>
+static void LoadAs(const void* data, ValueType& value)
+{
+	T typedValue;
+	std::memcpy(&typedValue, data, sizeof(T));
+	value = static_cast<ValueType>(typedValue);
+}
+
+template<typename T, typename ValueType>
+static void StoreAs(void* data, const ValueType value)
+{
+	const T typedValue = static_cast<T>(value);
+	std::memcpy(data, &typedValue, sizeof(T));
+}
+
+// Out of range values saturate, converting them would be truncated or undefined
+template<typename T, typename ValueType>
+static void StoreClamped(void* data, const ValueType value)
+{
+	const ValueType lowest = static_cast<ValueType>(std::numeric_limits<T>::lowest());
+	const ValueType highest = static_cast<ValueType>(std::numeric_limits<T>::max());
+	StoreAs<T>(data, std::min(std::max(value, lowest), highest));
+}
+
+template<typename T, BasicTypeCategory category = GetBasicTypeCategory<T>()>
+struct BasicTypeAccess;
+
+template<typename T>
+struct BasicTypeAccess<T, BasicTypeCategory::Signed>
+{
+	static void Load(const void* data, BasicValue& value) { LoadAs<T>(data, value.signedValue); }
+	static void Store(void* data, const BasicValue& value) { StoreClamped<T>(data, value.signedValue); }
+};
+
+template<typename T>
+struct BasicTypeAccess<T, BasicTypeCategory::Unsigned>
+{
+	static void Load(const void* data, BasicValue& value) { LoadAs<T>(data, value.unsignedValue); }
+	static void Store(void* data, const BasicValue& value) { StoreClamped<T>(data, value.unsignedValue); }
+};
+
+template<typename T>
+struct BasicTypeAccess<T, BasicTypeCategory::Floating>
+{
+	static void Load(const void* data, BasicValue& value) { LoadAs<T>(data, value.floatingValue); }
+	static void Store(void* data, const BasicValue& value)
+	{
+		// Only finite values saturate, infinities and NaN are kept
+		if (std::isfinite(value.floatingValue))
+		{
+			StoreClamped<T>(data, value.floatingValue);
+		}
+		else
+		{
+			StoreAs<T>(data, value.floatingValue);
+		}
+	}
+};
+
+template<typename T>
+struct BasicTypeAccess<T, BasicTypeCategory::Bool>
+{
+	static void Load(const void* data, BasicValue& value) { LoadAs<T>(data, value.boolValue); }
+	static void Store(void* data, const BasicValue& value) { StoreAs<T>(data, value.boolValue); }
+};
+
+template<size_t index>
+constexpr BasicTypeCodec MakeBasicTypeCodec()
+{
+	using Type = decltype(IdToType(TypeId_<index>()));
+	static_assert(TypeToId<Type>() == index, "Basic type is registered with another index");
+
+	BasicTypeCodec codec;
+	codec.category = GetBasicTypeCategory<Type>();
+	codec.size = sizeof(Type);
+	codec.load = BasicTypeAccess<Type>::Load;
+	codec.store = BasicTypeAccess<Type>::Store;
+	return codec;
+}
+
+static void LoadNothing(const void*, BasicValue& value)
+{
+	value.unsignedValue = 0U;
+}
+
+static void StoreNothing(void*, const BasicValue&)
+{
+}
+
+constexpr BasicTypeCodec MakeUnknownTypeCodec()
+{
+	BasicTypeCodec codec;
+	codec.load = LoadNothing;
+	codec.store = StoreNothing;
+	return codec;
+}
+
+// Built at compile time, so the table is usable during static initialization too
+constexpr BasicTypeCodec basicTypeCodecs[BT_COUNT] =
+{
+	MakeUnknownTypeCodec(),
+	MakeBasicTypeCodec<BT_INT_8>(),
+	MakeBasicTypeCodec<BT_INT_16>(),
+	MakeBasicTypeCodec<BT_INT_32>(),
+	MakeBasicTypeCodec<BT_INT_64>(),
+	MakeBasicTypeCodec<BT_UNSIGNED_INT_8>(),
+	MakeBasicTypeCodec<BT_UNSIGNED_INT_16>(),
+	MakeBasicTypeCodec<BT_UNSIGNED_INT_32>(),
+	MakeBasicTypeCodec<BT_UNSIGNED_INT_64>(),
+	MakeBasicTypeCodec<BT_FLOAT>(),
+	MakeBasicTypeCodec<BT_DOUBLE>(),
+	MakeBasicTypeCodec<BT_BOOL>(),
+	MakeBasicTypeCodec<BT_CHAR>()
+};
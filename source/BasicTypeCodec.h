@@ -0,0 +1,43 @@
+#ifndef BASIC_TYPE_CODEC_INCLUDE
+#define BASIC_TYPE_CODEC_INCLUDE
+
+#include "TypeInfo.h"
+
+// Widest representation of a fundamental value, the member in use depends on the category
+union BasicValue
+{
+	int64_t signedValue;
+	uint64_t unsignedValue;
+	double floatingValue;
+	bool boolValue;
+};
+
+enum class BasicTypeCategory
+{
+	None,
+	Signed,
+	Unsigned,
+	Floating,
+	Bool
+};
+
+// Converts fundamental values and enums of any width to BasicValue and back.
+// Backends switch over the few categories instead of every BasicType.
+struct BasicTypeCodec
+{
+	BasicTypeCategory category = BasicTypeCategory::None;
+	size_t size = 0U;
+	void (*load)(const void* data, BasicValue& value) = nullptr;
+	void (*store)(void* data, const BasicValue& value) = nullptr;
+};
+
+// Indexed by BasicType, entry 0 is the codec of unknown types and does nothing
+extern const BasicTypeCodec basicTypeCodecs[BT_COUNT];
+
+inline const BasicTypeCodec& GetBasicTypeCodec(const TypeInfo& typeInfo)
+{
+	const size_t typeIndex = typeInfo.fundamentalTypeParams.typeIndex;
+	return basicTypeCodecs[typeIndex < BT_COUNT ? typeIndex : 0U];
+}
+
+#endif
@@ -0,0 +1,92 @@
+#include "BinaryArchiveReader.h"
+
+#include <cstring>
+
+constexpr size_t BinaryArchiveReader::InvalidOffset;
+
+static uint32_t LoadUInt32(const uint8_t* data)
+{
+	uint32_t value = 0U;
+	std::memcpy(&value, data, sizeof(uint32_t));
+	return value;
+}
+
+BinaryArchiveReader::BinaryArchiveReader(const void* data, const size_t size)
+	: m_data(reinterpret_cast<const uint8_t*>(data))
+	, m_size(size)
+{
+	m_decoder.SetInput(data, size);
+}
+
+bool BinaryArchiveReader::NextObject(const ObjectDesc& objectDesc)
+{
+	auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const size_t planIndex = plans.GetPlanIndex(objectDesc.GetId());
+	const size_t fieldsCount = plans.GetPlan(planIndex).stepsCount;
+
+	// Root objects end at the pointers section or at the end of the archive
+	const size_t tableSize = (fieldsCount + 1U) * sizeof(uint32_t);
+	if (m_nextObjectPosition + tableSize > m_size ||
+		LoadUInt32(m_data + m_nextObjectPosition) == BinarySerializer::PointersSectionMark)
+	{
+		m_planIndex = SerializationPlans::InvalidIndex;
+		m_fieldsCount = 0U;
+		return false;
+	}
+
+	m_planIndex = planIndex;
+	m_fieldsCount = fieldsCount;
+	m_tablePosition = m_nextObjectPosition + sizeof(uint32_t);
+	m_dataPosition = m_nextObjectPosition + tableSize;
+	m_dataSize = LoadUInt32(m_data + m_nextObjectPosition);
+	assert(m_dataPosition + m_dataSize <= m_size);
+
+	// Only the table is touched, the next object starts right after the data
+	m_nextObjectPosition = m_dataPosition + m_dataSize;
+	return true;
+}
+
+size_t BinaryArchiveReader::FindStep(const std::string& name) const
+{
+	if (m_planIndex == SerializationPlans::InvalidIndex)
+	{
+		return SerializationPlans::InvalidIndex;
+	}
+
+	const auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	return plans.FindStep(plans.GetPlan(m_planIndex), name.data(), name.size());
+}
+
+size_t BinaryArchiveReader::GetFieldOffset(const std::string& name) const
+{
+	const size_t stepIndex = FindStep(name);
+	if (stepIndex == SerializationPlans::InvalidIndex)
+	{
+		return InvalidOffset;
+	}
+	return LoadUInt32(m_data + m_tablePosition + stepIndex * sizeof(uint32_t));
+}
+
+bool BinaryArchiveReader::ReadField(const std::string& name, const TypeInfo& typeInfo, void* value)
+{
+	const size_t stepIndex = FindStep(name);
+	if (stepIndex == SerializationPlans::InvalidIndex)
+	{
+		return false;
+	}
+
+	const auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const SerializationStep& step = plans.GetSteps(plans.GetPlan(m_planIndex))[stepIndex];
+	if (step.typeInfo != &typeInfo)
+	{
+		return false;
+	}
+
+	m_decoder.m_readPosition = m_dataPosition + LoadUInt32(m_data + m_tablePosition + stepIndex * sizeof(uint32_t));
+	m_decoder.DeserializeByType(*step.typeInfo, value, step.nestedPlanIndex);
+	assert(m_decoder.m_readPosition <= m_dataPosition + m_dataSize);
+
+	// Nothing resolves pointer ids here, the pointers stay as they were
+	m_decoder.m_pointerSlots.clear();
+	return true;
+}
@@ -0,0 +1,59 @@
+#ifndef BINARY_ARCHIVE_READER_INCLUDE
+#define BINARY_ARCHIVE_READER_INCLUDE
+
+#include "BinarySerializer.h"
+
+// Reads single properties of root objects written with field tables, see
+// BinarySerializer::SetFieldTablesEnabled. Objects are skipped as a whole and only
+// the bytes of the requested properties are decoded. The archive is read in place
+// and must outlive the reader. Pointer properties are not resolved.
+class BinaryArchiveReader
+{
+public:
+	static constexpr size_t InvalidOffset = static_cast<size_t>(-1);
+
+	BinaryArchiveReader(const void* data, const size_t size);
+
+	// Moves to the next root object, which must be of ObjectType like with Deserialize.
+	// False when there are no more objects.
+	template<typename ObjectType>
+	bool NextObject()
+	{
+		return NextObject(ObjectFactory::GetInstance().GetObjectDesc<ObjectType>());
+	}
+	bool NextObject(const ObjectDesc& objectDesc);
+
+	// Offset of the property value from the start of the current object data, or InvalidOffset
+	size_t GetFieldOffset(const std::string& name) const;
+	size_t GetFieldsCount() const { return m_fieldsCount; }
+	// Bytes of the current object data
+	size_t GetObjectSize() const { return m_dataSize; }
+
+	// Decodes one property of the current object.
+	// False when the object has no such property or FieldType is not the property type.
+	template<typename FieldType>
+	bool ReadField(const std::string& name, FieldType& value)
+	{
+		const TypeInfo* typeInfo = TypeInfoCollection::GetInstance().GetOrRegisterTypeInfo<FieldType>();
+		return ReadField(name, *typeInfo, &value);
+	}
+
+private:
+	size_t FindStep(const std::string& name) const;
+	bool ReadField(const std::string& name, const TypeInfo& typeInfo, void* value);
+
+	const uint8_t* m_data = nullptr;
+	size_t m_size = 0U;
+	size_t m_nextObjectPosition = 0U;
+
+	size_t m_planIndex = SerializationPlans::InvalidIndex;
+	size_t m_tablePosition = 0U;
+	size_t m_dataPosition = 0U;
+	size_t m_dataSize = 0U;
+	size_t m_fieldsCount = 0U;
+
+	// Decodes property values from the archive in place
+	BinarySerializer m_decoder;
+};
+
+#endif
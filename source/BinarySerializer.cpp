@@ -0,0 +1,765 @@
+#include "BinarySerializer.h"
+
+constexpr uint32_t BinarySerializer::PointersSectionMark;
+
+// Elements are stored as raw bytes one after another, so the whole block can be copied at once
+static bool IsBulkCopyable(const TypeInfo& arrayTypeInfo)
+{
+	const auto& arrayParams = arrayTypeInfo.arrayParams;
+	if (!arrayParams.isTriviallyCopyable)
+	{
+		return false;
+	}
+
+	const auto& elementTypeInfo = *arrayParams.elementTypeInfo;
+	switch (elementTypeInfo.type)
+	{
+	case TypeInfo::Fundamental:
+	case TypeInfo::Enum:
+		return elementTypeInfo.fundamentalTypeParams.typeSize == arrayParams.elementSize;
+	case TypeInfo::Array:
+	{
+		const auto& elementArrayParams = elementTypeInfo.arrayParams;
+		const bool isFixedSize = elementArrayParams.arrayType != TypeInfo::ArrayType::Vector;
+		const bool isTightlyPacked = elementArrayParams.elementsCount * elementArrayParams.elementSize == arrayParams.elementSize;
+		return isFixedSize && isTightlyPacked && IsBulkCopyable(elementTypeInfo);
+	}
+	default:
+		return false;
+	}
+}
+
+void BinarySerializer::Clear()
+{
+	Serializer::Clear();
+	m_buffer.clear();
+	m_readPosition = 0U;
+	m_input = nullptr;
+	m_inputSize = 0U;
+	m_objectIds.clear();
+	m_objectsById.clear();
+	m_writtenRecordsCount = 0U;
+	m_recordTypeIndices.clear();
+	m_objectRecords.clear();
+	m_recordTypes.clear();
+	m_pointerSlots.clear();
+}
+
+void BinarySerializer::SetBuffer(const void* data, const size_t size)
+{
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+	m_buffer.assign(bytes, bytes + size);
+	SetInput(nullptr, 0U);
+}
+
+void BinarySerializer::SetInput(const void* data, const size_t size)
+{
+	m_input = reinterpret_cast<const uint8_t*>(data);
+	m_inputSize = size;
+	m_readPosition = 0U;
+
+	// Objects of the previous input may be gone already, e.g. released with their allocator
+	m_objectRecords.clear();
+	m_recordTypes.clear();
+	m_pointerSlots.clear();
+}
+
+void BinarySerializer::Write(const void* data, const size_t size)
+{
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+	m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+}
+
+void BinarySerializer::Read(void* data, const size_t size)
+{
+	assert(m_readPosition + size <= GetInputSize());
+	std::memcpy(data, GetInputData() + m_readPosition, size);
+	m_readPosition += size;
+}
+
+const uint8_t* BinarySerializer::GetInputData() const
+{
+	// Batch workers read straight from the owner input
+	const BinarySerializer& source = m_batchOwner ? *m_batchOwner : *this;
+	return source.m_input ? source.m_input : source.m_buffer.data();
+}
+
+size_t BinarySerializer::GetInputSize() const
+{
+	const BinarySerializer& source = m_batchOwner ? *m_batchOwner : *this;
+	return source.m_input ? source.m_inputSize : source.m_buffer.size();
+}
+
+void BinarySerializer::WriteVarint(uint64_t value)
+{
+	// 7 bits per byte, the high bit marks that more bytes follow
+	uint8_t bytes[10];
+	size_t size = 0U;
+	while (value >= 0x80U)
+	{
+		bytes[size++] = static_cast<uint8_t>(value | 0x80U);
+		value >>= 7;
+	}
+	bytes[size++] = static_cast<uint8_t>(value);
+	Write(bytes, size);
+}
+
+uint64_t BinarySerializer::ReadVarint()
+{
+	uint64_t value = 0U;
+	for (unsigned shift = 0U; shift < 64U; shift += 7U)
+	{
+		const uint8_t byte = ReadValue<uint8_t>();
+		value |= static_cast<uint64_t>(byte & 0x7FU) << shift;
+		if ((byte & 0x80U) == 0U)
+		{
+			break;
+		}
+	}
+	return value;
+}
+
+size_t BinarySerializer::GetVarintSize(uint64_t value)
+{
+	size_t size = 1U;
+	while (value >= 0x80U)
+	{
+		value >>= 7;
+		++size;
+	}
+	return size;
+}
+
+size_t BinarySerializer::GetObjectId(void* pointer, const TypeInfo* typeInfo)
+{
+	auto findIt = m_objectIds.find(pointer);
+	if (findIt != m_objectIds.end())
+	{
+		return findIt->second;
+	}
+
+	// Root objects serialized through a pointer are not written again
+	if (m_serializedPointers.find(pointer) != m_serializedPointers.end())
+	{
+		return 0U;
+	}
+
+	ObjectToSerialize objectToSerialize;
+	objectToSerialize.object = pointer;
+	objectToSerialize.typeInfo = typeInfo;
+	m_objectsById.push_back(objectToSerialize);
+
+	const size_t id = m_objectsById.size();
+	m_objectIds.emplace(pointer, id);
+	return id;
+}
+
+void BinarySerializer::SerializePointers()
+{
+	// Tells BinaryArchiveReader where the root objects end
+	if (m_hasFieldTables)
+	{
+		WriteValue<uint32_t>(PointersSectionMark);
+	}
+
+	// Records are written in id order. Pointed-to objects may contain pointers
+	// themselves, so every round writes the objects met during the previous one.
+	while (m_writtenRecordsCount < m_objectsById.size())
+	{
+		const size_t roundEnd = m_objectsById.size();
+		WriteVarint(roundEnd - m_writtenRecordsCount);
+
+		for (size_t i = m_writtenRecordsCount; i < roundEnd; ++i)
+		{
+			void* valueAddress = m_objectsById[i].object;
+			auto actualTypeInfo = m_objectsById[i].typeInfo->pointerParams.getActualTypeInfo(valueAddress);
+
+			// Type names are written once, later records refer to them by index
+			const auto typeIndexResult = m_recordTypeIndices.emplace(actualTypeInfo, m_recordTypeIndices.size());
+			WriteVarint(typeIndexResult.first->second);
+			if (typeIndexResult.second)
+			{
+				const auto& typeName = actualTypeInfo->GetName();
+				WriteVarint(typeName.size());
+				Write(typeName.data(), typeName.size());
+			}
+
+			// Reserve room for the value size so unused records can be skipped on load
+			const size_t sizePosition = m_buffer.size();
+			WriteValue<uint64_t>(0U);
+
+			SerializeByType(*actualTypeInfo, valueAddress);
+
+			const uint64_t valueSize = m_buffer.size() - sizePosition - sizeof(uint64_t);
+			std::memcpy(m_buffer.data() + sizePosition, &valueSize, sizeof(uint64_t));
+		}
+		m_writtenRecordsCount = roundEnd;
+	}
+
+	// Empty round terminates the pointers section
+	WriteVarint(0U);
+}
+
+void BinarySerializer::DeserializePointers()
+{
+	auto& typeInfoCollection = TypeInfoCollection::GetInstance();
+
+	if (m_hasFieldTables)
+	{
+		const uint32_t mark = ReadValue<uint32_t>();
+		assert(mark == PointersSectionMark && "Pointers section is not where expected");
+		(void)mark;
+	}
+
+	// Index the whole section first: a record may be referenced by an object stored before it
+	for (size_t recordsCount = ReadVarint(); recordsCount > 0U; recordsCount = ReadVarint())
+	{
+		for (size_t i = 0U; i < recordsCount; ++i)
+		{
+			const size_t typeIndex = static_cast<size_t>(ReadVarint());
+			assert(typeIndex <= m_recordTypes.size());
+			if (typeIndex == m_recordTypes.size())
+			{
+				std::string typeName(static_cast<size_t>(ReadVarint()), '\0');
+				Read(&typeName[0], typeName.size());
+				m_recordTypes.push_back(typeInfoCollection.GetTypeInfo(typeName));
+			}
+			const size_t valueSize = static_cast<size_t>(ReadValue<uint64_t>());
+
+			ObjectRecord record;
+			record.typeInfo = m_recordTypes[typeIndex];
+			record.valuePosition = m_readPosition;
+			m_objectRecords.push_back(record);
+
+			m_readPosition += valueSize;
+		}
+	}
+	const size_t sectionEnd = m_readPosition;
+
+	// Objects are created first, creating them may add more slots.
+	// The slots are patched all at once afterwards.
+	for (size_t i = 0U; i < m_pointerSlots.size(); ++i)
+	{
+		const size_t id = m_pointerSlots[i].first;
+		if (id > m_objectRecords.size() || m_objectRecords[id - 1U].typeInfo == nullptr)
+		{
+			continue;
+		}
+
+		auto& record = m_objectRecords[id - 1U];
+		if (record.object == nullptr)
+		{
+			record.object = record.typeInfo->CreateValue(m_objectAllocator);
+
+			m_readPosition = record.valuePosition;
+			DeserializeByType(*record.typeInfo, record.object);
+		}
+	}
+
+	const size_t slotsPerTask = 4096U;
+	const size_t tasksCount = (m_pointerSlots.size() + slotsPerTask - 1U) / slotsPerTask;
+	ParallelFor(tasksCount, m_workersCount, [this, slotsPerTask](const size_t task, const size_t)
+	{
+		const size_t lastSlot = std::min(m_pointerSlots.size(), (task + 1U) * slotsPerTask);
+		for (size_t i = task * slotsPerTask; i < lastSlot; ++i)
+		{
+			const size_t id = m_pointerSlots[i].first;
+			if (id <= m_objectRecords.size() && m_objectRecords[id - 1U].object != nullptr)
+			{
+				*reinterpret_cast<void**>(m_pointerSlots[i].second) = m_objectRecords[id - 1U].object;
+			}
+		}
+	});
+	m_pointerSlots.clear();
+
+	m_readPosition = sectionEnd;
+}
+
+void BinarySerializer::SerializeInternal(const ObjectDesc& objectDesc, void* object)
+{
+	auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const size_t planIndex = plans.GetPlanIndex(objectDesc.GetId());
+	if (m_hasFieldTables)
+	{
+		SerializeWithFieldTable(planIndex, object);
+	}
+	else
+	{
+		SerializePlan(planIndex, object);
+	}
+}
+
+void BinarySerializer::DeserializeInternal(const ObjectDesc& objectDesc, void* object)
+{
+	auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const size_t planIndex = plans.GetPlanIndex(objectDesc.GetId());
+	if (m_hasFieldTables)
+	{
+		// The whole object is decoded, so the offsets are not needed
+		const size_t dataSize = ReadValue<uint32_t>();
+		m_readPosition += plans.GetPlan(planIndex).stepsCount * sizeof(uint32_t);
+		const size_t dataEnd = m_readPosition + dataSize;
+
+		DeserializePlan(planIndex, object);
+		assert(m_readPosition == dataEnd && "Object does not match its field table");
+		(void)dataEnd;
+	}
+	else
+	{
+		DeserializePlan(planIndex, object);
+	}
+}
+
+std::vector<std::unique_ptr<BinarySerializer>> BinarySerializer::CreateBatchWorkers(const size_t tasksCount)
+{
+	std::vector<std::unique_ptr<BinarySerializer>> workers(std::max<size_t>(1U, std::min(m_workersCount, tasksCount)));
+	for (auto& worker : workers)
+	{
+		worker.reset(new BinarySerializer());
+		worker->m_batchOwner = this;
+	}
+	return workers;
+}
+
+void BinarySerializer::SerializeBatchInternal(const ObjectDesc& objectDesc, const void* objects, const size_t stride, const size_t count)
+{
+	// Compile plans before the workers start using them
+	auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const size_t planIndex = plans.GetPlanIndex(objectDesc.GetId());
+
+	// Several chunks per worker even out objects of different sizes
+	const size_t chunksPerWorker = 8U;
+	const size_t objectsPerChunk = std::max<size_t>(1U, count / (m_workersCount * chunksPerWorker));
+	const size_t chunksCount = (count + objectsPerChunk - 1U) / objectsPerChunk;
+	const char* objectBytes = reinterpret_cast<const char*>(objects);
+
+	// Nothing runs in parallel, so the objects are written in place as one chunk
+	if (m_workersCount == 1U || chunksCount == 1U)
+	{
+		WriteValue<uint32_t>(1U);
+		WriteValue<uint32_t>(static_cast<uint32_t>(count));
+		const size_t sizePosition = m_buffer.size();
+		WriteValue<uint64_t>(0U);
+
+		const size_t dataPosition = m_buffer.size();
+		for (size_t i = 0U; i < count; ++i)
+		{
+			SerializePlan(planIndex, const_cast<char*>(objectBytes + i * stride));
+		}
+		const uint64_t chunkSize = m_buffer.size() - dataPosition;
+		std::memcpy(m_buffer.data() + sizePosition, &chunkSize, sizeof(uint64_t));
+		return;
+	}
+
+	// Every chunk is written to its own buffer, buffers are joined in order afterwards
+	std::vector<std::vector<uint8_t>> chunkBuffers(chunksCount);
+	std::vector<std::vector<BatchPointerSlot>> chunkPointerSlots(chunksCount);
+	auto workers = CreateBatchWorkers(chunksCount);
+	ParallelFor(chunksCount, workers.size(), [&](const size_t chunk, const size_t workerIndex)
+	{
+		BinarySerializer& worker = *workers[workerIndex];
+		const size_t lastObject = std::min(count, (chunk + 1U) * objectsPerChunk);
+		for (size_t i = chunk * objectsPerChunk; i < lastObject; ++i)
+		{
+			worker.SerializePlan(planIndex, const_cast<char*>(objectBytes + i * stride));
+		}
+		chunkBuffers[chunk].swap(worker.m_buffer);
+		chunkPointerSlots[chunk].swap(worker.m_batchPointerSlots);
+	});
+
+	// Ids are given in document order, exactly like when serializing one by one
+	std::vector<size_t> chunkIds;
+	std::vector<size_t> chunkSizes(chunksCount);
+	for (size_t chunk = 0U; chunk < chunksCount; ++chunk)
+	{
+		chunkSizes[chunk] = chunkBuffers[chunk].size();
+		for (const auto& slot : chunkPointerSlots[chunk])
+		{
+			const size_t id = GetObjectId(slot.pointer, slot.typeInfo);
+			chunkIds.push_back(id);
+			chunkSizes[chunk] += GetVarintSize(id);
+		}
+	}
+
+	// Chunk table: objects count and size of every chunk, so chunks can be found without decoding
+	WriteValue<uint32_t>(static_cast<uint32_t>(chunksCount));
+	size_t batchSize = 0U;
+	for (size_t chunk = 0U; chunk < chunksCount; ++chunk)
+	{
+		const size_t lastObject = std::min(count, (chunk + 1U) * objectsPerChunk);
+		WriteValue<uint32_t>(static_cast<uint32_t>(lastObject - chunk * objectsPerChunk));
+		WriteValue<uint64_t>(chunkSizes[chunk]);
+		batchSize += chunkSizes[chunk];
+	}
+
+	m_buffer.reserve(m_buffer.size() + batchSize);
+	size_t idIndex = 0U;
+	for (size_t chunk = 0U; chunk < chunksCount; ++chunk)
+	{
+		const auto& chunkBuffer = chunkBuffers[chunk];
+		size_t copiedSize = 0U;
+		for (const auto& slot : chunkPointerSlots[chunk])
+		{
+			Write(chunkBuffer.data() + copiedSize, slot.position - copiedSize);
+			WriteVarint(chunkIds[idIndex++]);
+			copiedSize = slot.position;
+		}
+		Write(chunkBuffer.data() + copiedSize, chunkBuffer.size() - copiedSize);
+	}
+}
+
+void BinarySerializer::DeserializeBatchInternal(const ObjectDesc& objectDesc, void* objects, const size_t stride, const size_t count)
+{
+	auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const size_t planIndex = plans.GetPlanIndex(objectDesc.GetId());
+
+	struct Chunk
+	{
+		size_t firstObject = 0U;
+		size_t objectsCount = 0U;
+		size_t position = 0U;
+	};
+
+	std::vector<Chunk> chunks(ReadValue<uint32_t>());
+	size_t firstObject = 0U;
+	size_t position = 0U;
+	for (auto& chunk : chunks)
+	{
+		chunk.firstObject = firstObject;
+		chunk.objectsCount = ReadValue<uint32_t>();
+		chunk.position = position;
+		firstObject += chunk.objectsCount;
+		position += static_cast<size_t>(ReadValue<uint64_t>());
+	}
+	assert(firstObject == count && "Batch was serialized with another objects count");
+	assert(m_readPosition + position <= GetInputSize());
+
+	char* objectBytes = reinterpret_cast<char*>(objects);
+
+	// Chunks follow each other, a single worker decodes them in place one after another
+	if (m_workersCount == 1U || chunks.size() == 1U)
+	{
+		const size_t batchEnd = m_readPosition + position;
+		for (size_t i = 0U; i < count; ++i)
+		{
+			DeserializePlan(planIndex, objectBytes + i * stride);
+		}
+		assert(m_readPosition == batchEnd && "Batch chunks are not read completely");
+		(void)batchEnd;
+		return;
+	}
+
+	for (auto& chunk : chunks)
+	{
+		chunk.position += m_readPosition;
+	}
+	m_readPosition += position;
+
+	auto workers = CreateBatchWorkers(chunks.size());
+	ParallelFor(chunks.size(), workers.size(), [&](const size_t chunkIndex, const size_t workerIndex)
+	{
+		BinarySerializer& worker = *workers[workerIndex];
+		const Chunk& chunk = chunks[chunkIndex];
+		worker.m_readPosition = chunk.position;
+		for (size_t i = chunk.firstObject; i < chunk.firstObject + chunk.objectsCount && i < count; ++i)
+		{
+			worker.DeserializePlan(planIndex, objectBytes + i * stride);
+		}
+	});
+
+	// Pointer slots are resolved later by DeserializePointers
+	for (auto& worker : workers)
+	{
+		m_pointerSlots.insert(m_pointerSlots.end(), worker->m_pointerSlots.begin(), worker->m_pointerSlots.end());
+	}
+}
+
+void BinarySerializer::SerializePlan(const size_t planIndex, void* object)
+{
+	const auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const auto& plan = plans.GetPlan(planIndex);
+	const SerializationStep* steps = plans.GetSteps(plan);
+
+	for (size_t i = 0U; i < plan.stepsCount; ++i)
+	{
+		const auto& step = steps[i];
+		TempStack::Scope tempScope(m_tempStack);
+		void* data = step.GetData(object, m_tempStack);
+
+		SerializeByType(*step.typeInfo, data, step.nestedPlanIndex);
+	}
+}
+
+void BinarySerializer::SerializeWithFieldTable(const size_t planIndex, void* object)
+{
+	const auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const auto& plan = plans.GetPlan(planIndex);
+	const SerializationStep* steps = plans.GetSteps(plan);
+
+	// Data size and the offset of every step from the data start, filled in afterwards
+	const size_t tablePosition = m_buffer.size();
+	m_buffer.resize(tablePosition + (plan.stepsCount + 1U) * sizeof(uint32_t));
+	const size_t dataPosition = m_buffer.size();
+
+	for (size_t i = 0U; i < plan.stepsCount; ++i)
+	{
+		const uint32_t offset = static_cast<uint32_t>(m_buffer.size() - dataPosition);
+		std::memcpy(m_buffer.data() + tablePosition + (i + 1U) * sizeof(uint32_t), &offset, sizeof(uint32_t));
+
+		const auto& step = steps[i];
+		TempStack::Scope tempScope(m_tempStack);
+		void* data = step.GetData(object, m_tempStack);
+
+		SerializeByType(*step.typeInfo, data, step.nestedPlanIndex);
+	}
+
+	assert(m_buffer.size() - dataPosition <= UINT32_MAX);
+	const uint32_t dataSize = static_cast<uint32_t>(m_buffer.size() - dataPosition);
+	std::memcpy(m_buffer.data() + tablePosition, &dataSize, sizeof(uint32_t));
+}
+
+void BinarySerializer::DeserializePlan(const size_t planIndex, void* object)
+{
+	const auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const auto& plan = plans.GetPlan(planIndex);
+	const SerializationStep* steps = plans.GetSteps(plan);
+
+	for (size_t i = 0U; i < plan.stepsCount; ++i)
+	{
+		const auto& step = steps[i];
+		TempStack::Scope tempScope(m_tempStack);
+		void* data = step.GetData(object, m_tempStack);
+
+		DeserializeByType(*step.typeInfo, data, step.nestedPlanIndex);
+
+		// Direct fields were written in place, only accessors need to be called
+		if (!step.IsDirectField())
+		{
+			step.MoveValue(object, data);
+		}
+	}
+}
+
+void BinarySerializer::SerializeByType(const TypeInfo& typeInfo, void* data, size_t planIndex)
+{
+	switch (typeInfo.type)
+	{
+	case TypeInfo::Fundamental:
+	case TypeInfo::Enum:
+	{
+		Write(data, typeInfo.fundamentalTypeParams.typeSize);
+	}
+	break;
+	case TypeInfo::Class:
+	{
+		if (planIndex == SerializationPlans::InvalidIndex)
+		{
+			auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+			planIndex = plans.GetPlanIndex(typeInfo.GetObjectDescId());
+		}
+		SerializePlan(planIndex, data);
+	}
+	break;
+	case TypeInfo::String:
+	{
+		auto str = reinterpret_cast<std::string*>(data);
+		WriteValue<uint32_t>(static_cast<uint32_t>(str->size()));
+		Write(str->data(), str->size());
+	}
+	break;
+	case TypeInfo::View:
+	{
+		auto view = reinterpret_cast<ArchiveViewData*>(data);
+		WriteValue<uint32_t>(static_cast<uint32_t>(view->GetBytesCount() / typeInfo.viewParams.elementSize));
+		Write(view->GetData(), view->GetBytesCount());
+	}
+	break;
+	case TypeInfo::Pointer:
+	{
+		void* actualPtr = *reinterpret_cast<void**>(data);
+		if (m_batchOwner)
+		{
+			// Ids must follow the document order, so batch workers leave them to the owner
+			BatchPointerSlot slot;
+			slot.position = m_buffer.size();
+			slot.pointer = actualPtr;
+			slot.typeInfo = typeInfo.pointerParams.underlyingType;
+			if (actualPtr != nullptr)
+			{
+				m_batchPointerSlots.push_back(slot);
+			}
+			else
+			{
+				WriteVarint(0U);
+			}
+		}
+		else
+		{
+			WriteVarint(actualPtr != nullptr ? GetObjectId(actualPtr, typeInfo.pointerParams.underlyingType) : 0U);
+		}
+	}
+	break;
+	case TypeInfo::Array:
+	{
+		size_t elementsCount = 0U;
+		const auto& elementTypeInfo = typeInfo.arrayParams.elementTypeInfo;
+
+		if (typeInfo.arrayParams.arrayType == TypeInfo::ArrayType::Vector)
+		{
+			elementsCount = typeInfo.arrayParams.getSize(data);
+			WriteValue<uint32_t>(static_cast<uint32_t>(elementsCount));
+		}
+		else
+		{
+			elementsCount = typeInfo.arrayParams.elementsCount;
+		}
+
+		if (IsBulkCopyable(typeInfo))
+		{
+			if (elementsCount > 0U)
+			{
+				Write(typeInfo.arrayParams.getData(data), elementsCount * typeInfo.arrayParams.elementSize);
+			}
+		}
+		else
+		{
+			for (size_t i = 0U; i < elementsCount; ++i)
+			{
+				void* currentDataAddress = typeInfo.arrayParams.getItem(data, i);
+				SerializeByType(*elementTypeInfo, currentDataAddress, planIndex);
+			}
+		}
+	}
+	break;
+	case TypeInfo::Map:
+	{
+		WriteValue<uint32_t>(static_cast<uint32_t>(typeInfo.mapParams.getSize(data)));
+
+		TypeInfo::MapParams::IteratorStorage iteratorStorage;
+		typeInfo.mapParams.initIterator(data, iteratorStorage);
+		void* it = iteratorStorage.data;
+		while (typeInfo.mapParams.isIteratorValid(it, data))
+		{
+			auto key = typeInfo.mapParams.getKey(it);
+			SerializeByType(*typeInfo.mapParams.keyTypeInfo, const_cast<void*>(key));
+
+			auto value = typeInfo.mapParams.getValue(it);
+			SerializeByType(*typeInfo.mapParams.valueTypeInfo, value);
+
+			typeInfo.mapParams.incrementIterator(it);
+		}
+	}
+	break;
+	default:
+		break;
+	}
+}
+
+void BinarySerializer::DeserializeByType(const TypeInfo& typeInfo, void* data, size_t planIndex)
+{
+	switch (typeInfo.type)
+	{
+	case TypeInfo::Fundamental:
+	case TypeInfo::Enum:
+	{
+		Read(data, typeInfo.fundamentalTypeParams.typeSize);
+	}
+	break;
+	case TypeInfo::Class:
+	{
+		if (planIndex == SerializationPlans::InvalidIndex)
+		{
+			auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+			planIndex = plans.GetPlanIndex(typeInfo.GetObjectDescId());
+		}
+		DeserializePlan(planIndex, data);
+	}
+	break;
+	case TypeInfo::String:
+	{
+		auto str = reinterpret_cast<std::string*>(data);
+		str->resize(ReadValue<uint32_t>());
+		if (!str->empty())
+		{
+			Read(&(*str)[0], str->size());
+		}
+	}
+	break;
+	case TypeInfo::View:
+	{
+		// Refers to the input instead of copying it
+		const size_t bytesCount = ReadValue<uint32_t>() * typeInfo.viewParams.elementSize;
+		assert(m_readPosition + bytesCount <= GetInputSize());
+		reinterpret_cast<ArchiveViewData*>(data)->Reset(GetInputData() + m_readPosition, bytesCount);
+		m_readPosition += bytesCount;
+	}
+	break;
+	case TypeInfo::Pointer:
+	{
+		const size_t id = static_cast<size_t>(ReadVarint());
+		if (id != 0U)
+		{
+			m_pointerSlots.emplace_back(id, data);
+		}
+	}
+	break;
+	case TypeInfo::Array:
+	{
+		size_t elementsCount = 0U;
+		const auto& elementTypeInfo = typeInfo.arrayParams.elementTypeInfo;
+
+		if (typeInfo.arrayParams.arrayType == TypeInfo::ArrayType::Vector)
+		{
+			elementsCount = ReadValue<uint32_t>();
+			typeInfo.arrayParams.setSize(data, elementsCount);
+		}
+		else
+		{
+			elementsCount = typeInfo.arrayParams.elementsCount;
+		}
+
+		if (IsBulkCopyable(typeInfo))
+		{
+			if (elementsCount > 0U)
+			{
+				Read(typeInfo.arrayParams.getData(data), elementsCount * typeInfo.arrayParams.elementSize);
+			}
+		}
+		else
+		{
+			for (size_t i = 0U; i < elementsCount; ++i)
+			{
+				void* currentDataAddress = typeInfo.arrayParams.getItem(data, i);
+				DeserializeByType(*elementTypeInfo, currentDataAddress, planIndex);
+			}
+		}
+	}
+	break;
+	case TypeInfo::Map:
+	{
+		const size_t elementsCount = ReadValue<uint32_t>();
+
+		const TypeInfo& keyTypeInfo = *typeInfo.mapParams.keyTypeInfo;
+		const TypeInfo& valueTypeInfo = *typeInfo.mapParams.valueTypeInfo;
+
+		// Values are read straight into the map nodes, so pointer slots refer to the map
+		typeInfo.mapParams.clear(data);
+
+		TempStack::Scope scope(m_tempStack);
+		TempContainer& keyContainer = m_tempStack.Push();
+		for (size_t i = 0U; i < elementsCount; ++i)
+		{
+			// Every key is read into a freshly constructed value
+			void* keyBuffer = keyContainer.Construct(keyTypeInfo.size, keyTypeInfo.alignment,
+				keyTypeInfo.constructValue, keyTypeInfo.destructValue);
+			DeserializeByType(keyTypeInfo, keyBuffer);
+
+			void* value = typeInfo.mapParams.emplaceValue(data, keyBuffer);
+			DeserializeByType(valueTypeInfo, value);
+		}
+	}
+	break;
+	default:
+		break;
+	}
+}
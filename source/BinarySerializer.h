@@ -0,0 +1,309 @@
+#ifndef BINARY_SERIALIZER_INCLUDE
+#define BINARY_SERIALIZER_INCLUDE
+
+#include "Serializer.h"
+#include "Parallel.h"
+#include "StaticFields.h"
+
+#include <vector>
+#include <cstdint>
+
+// Writes objects as a flat little-overhead byte stream. Objects must be
+// deserialized in the same order they were serialized, like JsonSerializer.
+// Pointers are stored as ids given to the pointed-to objects in the order they
+// are met, so the output does not depend on memory addresses.
+class BinarySerializer : public Serializer
+{
+public:
+	BinarySerializer() = default;
+
+	void Clear() override;
+
+	void SerializePointers() override;
+	void DeserializePointers() override;
+
+	// Serializes the objects on several threads. The batch is stored as chunks which
+	// DeserializeBatch decodes in parallel. Objects must not be modified meanwhile.
+	template<typename ObjectType>
+	void SerializeBatch(const ObjectType* objects, const size_t count)
+	{
+		const auto& objectDesc = ObjectFactory::GetInstance().GetObjectDesc<ObjectType>();
+		SerializeBatchInternal(objectDesc, objects, sizeof(ObjectType), count);
+	}
+
+	// The count must match the one the batch was serialized with
+	template<typename ObjectType>
+	void DeserializeBatch(ObjectType* objects, const size_t count)
+	{
+		const auto& objectDesc = ObjectFactory::GetInstance().GetObjectDesc<ObjectType>();
+		DeserializeBatchInternal(objectDesc, objects, sizeof(ObjectType), count);
+	}
+
+	// Types with StaticFields are walked by code generated for their field list, without
+	// plans or virtual calls. The bytes are the same as written by Serialize, so either
+	// side may use the dynamic path.
+	template<typename ObjectType>
+	void SerializeStatic(const ObjectType& object)
+	{
+		static_assert(HasStaticFields<ObjectType>::value, "ObjectType has no StaticFields");
+		if (m_hasFieldTables)
+		{
+			Serialize(object);
+			return;
+		}
+		WriteStatic(object);
+	}
+
+	template<typename ObjectType>
+	void DeserializeStatic(ObjectType& object)
+	{
+		static_assert(HasStaticFields<ObjectType>::value, "ObjectType has no StaticFields");
+		if (m_hasFieldTables)
+		{
+			Deserialize(object);
+			return;
+		}
+		ReadStatic(object);
+	}
+
+	// Root objects are written after a table of their field offsets, so BinaryArchiveReader
+	// can decode single properties and skip whole objects. Reading must use the same
+	// setting. Batches are always written without tables.
+	void SetFieldTablesEnabled(const bool enabled) { m_hasFieldTables = enabled; }
+
+	// Threads used by batches and by the pointer fixup of DeserializePointers
+	void SetWorkersCount(const size_t workersCount) { m_workersCount = workersCount > 0U ? workersCount : 1U; }
+
+	const std::vector<uint8_t>& GetBuffer() const { return m_buffer; }
+	// Copies the data, ArchiveView fields read afterwards refer to the copy
+	void SetBuffer(const void* data, const size_t size);
+	// Reads from external memory, e.g. a MappedFile, in place. Only the bytes of the
+	// values actually decoded are touched. The memory must outlive the reading and
+	// the ArchiveView fields read from it.
+	void SetInput(const void* data, const size_t size);
+
+protected:
+	void SerializeInternal(const ObjectDesc& objectDesc, void* object) override final;
+	void DeserializeInternal(const ObjectDesc& objectDesc, void* object) override final;
+	void SerializeBatchInternal(const ObjectDesc& objectDesc, const void* objects, const size_t stride, const size_t count);
+	void DeserializeBatchInternal(const ObjectDesc& objectDesc, void* objects, const size_t stride, const size_t count);
+
+	void SerializePlan(const size_t planIndex, void* object);
+	void DeserializePlan(const size_t planIndex, void* object);
+	void SerializeWithFieldTable(const size_t planIndex, void* object);
+
+	// planIndex is the plan of a Class value or of the innermost Class array element, if already known
+	void SerializeByType(const TypeInfo& typeInfo, void* data, size_t planIndex = SerializationPlans::InvalidIndex);
+	void DeserializeByType(const TypeInfo& typeInfo, void* data, size_t planIndex = SerializationPlans::InvalidIndex);
+
+private:
+	// Starts the pointers section of archives with field tables, no object data is this large
+	static constexpr uint32_t PointersSectionMark = static_cast<uint32_t>(-1);
+
+	void Write(const void* data, const size_t size);
+	void Read(void* data, const size_t size);
+	// Input of reading, the owner input for batch workers
+	const uint8_t* GetInputData() const;
+	size_t GetInputSize() const;
+	void WriteVarint(uint64_t value);
+	uint64_t ReadVarint();
+	static size_t GetVarintSize(uint64_t value);
+
+	// Id of the pointed-to object, a new object is queued for SerializePointers
+	size_t GetObjectId(void* pointer, const TypeInfo* typeInfo);
+	std::vector<std::unique_ptr<BinarySerializer>> CreateBatchWorkers(const size_t tasksCount);
+
+	template<typename T>
+	void WriteValue(const T value)
+	{
+		Write(&value, sizeof(T));
+	}
+
+	template<typename T>
+	T ReadValue()
+	{
+		T value = T();
+		Read(&value, sizeof(T));
+		return value;
+	}
+
+	// Static path, overloads follow the TypeInfo kinds of SerializeByType
+	template<typename T>
+	std::enable_if_t<std::is_arithmetic<T>::value || std::is_enum<T>::value> WriteStatic(const T& value)
+	{
+		WriteValue(value);
+	}
+
+	template<typename T>
+	std::enable_if_t<HasStaticFields<T>::value> WriteStatic(const T& object)
+	{
+		ForEachStaticField<T>([this, &object](const auto& field)
+		{
+			WriteStatic(object.*field.pointer);
+		});
+	}
+
+	// Pointers, maps and objects without a field list take the dynamic path
+	template<typename T>
+	std::enable_if_t<!std::is_arithmetic<T>::value && !std::is_enum<T>::value && !HasStaticFields<T>::value> WriteStatic(const T& value)
+	{
+		const TypeInfo* typeInfo = TypeInfoCollection::GetInstance().GetOrRegisterTypeInfo<T>();
+		SerializeByType(*typeInfo, const_cast<T*>(&value));
+	}
+
+	void WriteStatic(const std::string& value)
+	{
+		WriteValue<uint32_t>(static_cast<uint32_t>(value.size()));
+		Write(value.data(), value.size());
+	}
+
+	template<typename T>
+	void WriteStatic(const std::vector<T>& value)
+	{
+		WriteValue<uint32_t>(static_cast<uint32_t>(value.size()));
+		WriteStaticElements(value.data(), value.size());
+	}
+
+	template<typename T, size_t N>
+	void WriteStatic(const std::array<T, N>& value)
+	{
+		WriteStaticElements(value.data(), N);
+	}
+
+	template<typename T, size_t N>
+	void WriteStatic(const T (&value)[N])
+	{
+		WriteStaticElements(value, N);
+	}
+
+	template<typename T>
+	void WriteStaticElements(const T* elements, const size_t count)
+	{
+		if (std::is_arithmetic<T>::value || std::is_enum<T>::value)
+		{
+			Write(elements, count * sizeof(T));
+			return;
+		}
+		for (size_t i = 0U; i < count; ++i)
+		{
+			WriteStatic(elements[i]);
+		}
+	}
+
+	template<typename T>
+	std::enable_if_t<std::is_arithmetic<T>::value || std::is_enum<T>::value> ReadStatic(T& value)
+	{
+		Read(&value, sizeof(T));
+	}
+
+	template<typename T>
+	std::enable_if_t<HasStaticFields<T>::value> ReadStatic(T& object)
+	{
+		ForEachStaticField<T>([this, &object](const auto& field)
+		{
+			ReadStatic(object.*field.pointer);
+		});
+	}
+
+	template<typename T>
+	std::enable_if_t<!std::is_arithmetic<T>::value && !std::is_enum<T>::value && !HasStaticFields<T>::value> ReadStatic(T& value)
+	{
+		const TypeInfo* typeInfo = TypeInfoCollection::GetInstance().GetOrRegisterTypeInfo<T>();
+		DeserializeByType(*typeInfo, &value);
+	}
+
+	void ReadStatic(std::string& value)
+	{
+		value.resize(ReadValue<uint32_t>());
+		if (!value.empty())
+		{
+			Read(&value[0], value.size());
+		}
+	}
+
+	template<typename T>
+	void ReadStatic(std::vector<T>& value)
+	{
+		value.resize(ReadValue<uint32_t>());
+		ReadStaticElements(value.data(), value.size());
+	}
+
+	template<typename T, size_t N>
+	void ReadStatic(std::array<T, N>& value)
+	{
+		ReadStaticElements(value.data(), N);
+	}
+
+	template<typename T, size_t N>
+	void ReadStatic(T (&value)[N])
+	{
+		ReadStaticElements(value, N);
+	}
+
+	template<typename T>
+	void ReadStaticElements(T* elements, const size_t count)
+	{
+		if (std::is_arithmetic<T>::value || std::is_enum<T>::value)
+		{
+			if (count > 0U)
+			{
+				Read(elements, count * sizeof(T));
+			}
+			return;
+		}
+		for (size_t i = 0U; i < count; ++i)
+		{
+			ReadStatic(elements[i]);
+		}
+	}
+
+	struct ObjectToSerialize
+	{
+		void* object = nullptr;
+		const TypeInfo* typeInfo = nullptr;
+	};
+
+	struct ObjectRecord
+	{
+		const TypeInfo* typeInfo = nullptr;
+		size_t valuePosition = 0U;
+		void* object = nullptr;
+	};
+
+	// Pointer met by a batch worker, the id is written when the chunks are joined
+	struct BatchPointerSlot
+	{
+		size_t position = 0U;
+		void* pointer = nullptr;
+		const TypeInfo* typeInfo = nullptr;
+	};
+
+	std::vector<uint8_t> m_buffer;
+	size_t m_readPosition = 0U;
+	// External input set by SetInput, m_buffer is read when it is null
+	const uint8_t* m_input = nullptr;
+	size_t m_inputSize = 0U;
+
+	// Writing: object with id N is stored at N - 1
+	std::unordered_map<void*, size_t> m_objectIds;
+	std::vector<ObjectToSerialize> m_objectsById;
+	size_t m_writtenRecordsCount = 0U;
+	std::unordered_map<const TypeInfo*, size_t> m_recordTypeIndices;
+
+	// Reading: record of the object with id N is stored at N - 1
+	std::vector<ObjectRecord> m_objectRecords;
+	std::vector<const TypeInfo*> m_recordTypes;
+	// Object id and the address of the pointer to set
+	std::vector<std::pair<size_t, void*>> m_pointerSlots;
+
+	size_t m_workersCount = GetDefaultWorkersCount();
+	bool m_hasFieldTables = false;
+
+	// Set on the worker serializers of a batch, they read from the owner buffer
+	const BinarySerializer* m_batchOwner = nullptr;
+	std::vector<BatchPointerSlot> m_batchPointerSlots;
+
+	friend class BinaryArchiveReader;
+};
+
+#endif
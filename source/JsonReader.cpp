@@ -0,0 +1,654 @@
+#include "JsonReader.h"
+
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+
+constexpr size_t JsonReader::InvalidPosition;
+
+// Powers of ten which are exactly representable as double
+static const double exactPowersOf10[] =
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static bool IsDigit(const char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static int HexDigitValue(const char c)
+{
+	if (c >= '0' && c <= '9')
+	{
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f')
+	{
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F')
+	{
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+// Returns false if the digits do not fit into 64 bits
+static bool ParseDigits(const char* begin, const char* end, uint64_t& value)
+{
+	value = 0U;
+	for (const char* it = begin; it != end; ++it)
+	{
+		const uint64_t digit = static_cast<uint64_t>(*it - '0');
+		if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10U)
+		{
+			return false;
+		}
+		value = value * 10U + digit;
+	}
+	return true;
+}
+
+// Converting doubles out of the integer range is undefined, so they are clamped first
+static int64_t ClampToInt64(const double value)
+{
+	// 2^63 is exact in double, the minimal value is exact too
+	const double limit = 9223372036854775808.0;
+	if (value != value)
+	{
+		return 0;
+	}
+	if (value >= limit)
+	{
+		return std::numeric_limits<int64_t>::max();
+	}
+	if (value <= -limit)
+	{
+		return std::numeric_limits<int64_t>::min();
+	}
+	return static_cast<int64_t>(value);
+}
+
+static uint64_t ClampToUInt64(const double value)
+{
+	// 2^64 is exact in double
+	const double limit = 18446744073709551616.0;
+	if (value != value || value <= 0.0)
+	{
+		return 0U;
+	}
+	if (value >= limit)
+	{
+		return std::numeric_limits<uint64_t>::max();
+	}
+	return static_cast<uint64_t>(value);
+}
+
+static void AppendUtf8(std::string& output, const uint32_t codePoint)
+{
+	if (codePoint < 0x80U)
+	{
+		output.push_back(static_cast<char>(codePoint));
+	}
+	else if (codePoint < 0x800U)
+	{
+		output.push_back(static_cast<char>(0xC0U | (codePoint >> 6)));
+		output.push_back(static_cast<char>(0x80U | (codePoint & 0x3FU)));
+	}
+	else if (codePoint < 0x10000U)
+	{
+		output.push_back(static_cast<char>(0xE0U | (codePoint >> 12)));
+		output.push_back(static_cast<char>(0x80U | ((codePoint >> 6) & 0x3FU)));
+		output.push_back(static_cast<char>(0x80U | (codePoint & 0x3FU)));
+	}
+	else
+	{
+		output.push_back(static_cast<char>(0xF0U | (codePoint >> 18)));
+		output.push_back(static_cast<char>(0x80U | ((codePoint >> 12) & 0x3FU)));
+		output.push_back(static_cast<char>(0x80U | ((codePoint >> 6) & 0x3FU)));
+		output.push_back(static_cast<char>(0x80U | (codePoint & 0x3FU)));
+	}
+}
+
+void JsonReader::SetInput(const char* data, const size_t size)
+{
+	m_data = data;
+	m_size = size;
+	m_position = 0U;
+	m_scopes.clear();
+	m_hasError = false;
+}
+
+void JsonReader::SetError()
+{
+	m_hasError = true;
+	m_position = m_size;
+}
+
+bool JsonReader::Expect(const char c)
+{
+	SkipWhitespace();
+	if (m_position < m_size && m_data[m_position] == c)
+	{
+		++m_position;
+		return true;
+	}
+	SetError();
+	return false;
+}
+
+JsonReader::ValueType JsonReader::PeekValue()
+{
+	SkipWhitespace();
+	if (m_position >= m_size)
+	{
+		return ValueType::None;
+	}
+
+	switch (m_data[m_position])
+	{
+	case '{':
+		return ValueType::Object;
+	case '[':
+		return ValueType::Array;
+	case '"':
+		return ValueType::String;
+	case 't':
+	case 'f':
+		return ValueType::Bool;
+	case 'n':
+		return ValueType::Null;
+	default:
+		return ValueType::Number;
+	}
+}
+
+bool JsonReader::BeginObject()
+{
+	if (!Expect('{'))
+	{
+		return false;
+	}
+	m_scopes.push_back(false);
+	return true;
+}
+
+bool JsonReader::BeginArray()
+{
+	if (!Expect('['))
+	{
+		return false;
+	}
+	m_scopes.push_back(false);
+	return true;
+}
+
+bool JsonReader::NextInScope(const char closing)
+{
+	if (m_scopes.empty())
+	{
+		SetError();
+		return false;
+	}
+
+	SkipWhitespace();
+	if (m_hasError || m_position >= m_size)
+	{
+		SetError();
+		m_scopes.pop_back();
+		return false;
+	}
+
+	if (m_data[m_position] == closing)
+	{
+		++m_position;
+		m_scopes.pop_back();
+		return false;
+	}
+
+	if (m_scopes.back())
+	{
+		if (!Expect(','))
+		{
+			m_scopes.pop_back();
+			return false;
+		}
+	}
+	else
+	{
+		m_scopes.back() = true;
+	}
+	return true;
+}
+
+bool JsonReader::NextMember(const char*& name, size_t& length)
+{
+	if (!NextInScope('}'))
+	{
+		return false;
+	}
+
+	if (!ReadStringToken(name, length) || !Expect(':'))
+	{
+		m_scopes.pop_back();
+		return false;
+	}
+	return true;
+}
+
+bool JsonReader::NextElement()
+{
+	return NextInScope(']');
+}
+
+bool JsonReader::ReadStringToken(const char*& value, size_t& length)
+{
+	if (!Expect('"'))
+	{
+		return false;
+	}
+
+	// Strings without escape sequences are returned in place
+	const size_t begin = m_position;
+	while (m_position < m_size)
+	{
+		const char c = m_data[m_position];
+		if (c == '"')
+		{
+			value = m_data + begin;
+			length = m_position - begin;
+			++m_position;
+			return true;
+		}
+		if (c == '\\')
+		{
+			break;
+		}
+		if (static_cast<unsigned char>(c) < 0x20U)
+		{
+			SetError();
+			return false;
+		}
+		++m_position;
+	}
+
+	m_decodedString.assign(m_data + begin, m_position - begin);
+	while (m_position < m_size)
+	{
+		const char c = m_data[m_position++];
+		if (c == '"')
+		{
+			value = m_decodedString.data();
+			length = m_decodedString.size();
+			return true;
+		}
+		if (static_cast<unsigned char>(c) < 0x20U)
+		{
+			break;
+		}
+		if (c != '\\')
+		{
+			m_decodedString.push_back(c);
+			continue;
+		}
+
+		if (m_position >= m_size)
+		{
+			break;
+		}
+
+		const char escape = m_data[m_position++];
+		switch (escape)
+		{
+		case '"':
+		case '\\':
+		case '/':
+			m_decodedString.push_back(escape);
+			break;
+		case 'b':
+			m_decodedString.push_back('\b');
+			break;
+		case 'f':
+			m_decodedString.push_back('\f');
+			break;
+		case 'n':
+			m_decodedString.push_back('\n');
+			break;
+		case 'r':
+			m_decodedString.push_back('\r');
+			break;
+		case 't':
+			m_decodedString.push_back('\t');
+			break;
+		case 'u':
+		{
+			uint32_t codePoint = 0U;
+			for (int i = 0; i < 4; ++i)
+			{
+				const int digit = m_position < m_size ? HexDigitValue(m_data[m_position++]) : -1;
+				if (digit < 0)
+				{
+					SetError();
+					return false;
+				}
+				codePoint = (codePoint << 4) | static_cast<uint32_t>(digit);
+			}
+
+			// Characters outside of the basic plane are written as surrogate pairs
+			const bool isHighSurrogate = codePoint >= 0xD800U && codePoint <= 0xDBFFU;
+			if (isHighSurrogate && m_position + 6U <= m_size && m_data[m_position] == '\\' && m_data[m_position + 1U] == 'u')
+			{
+				uint32_t lowSurrogate = 0U;
+				for (size_t i = 2U; i < 6U; ++i)
+				{
+					const int digit = HexDigitValue(m_data[m_position + i]);
+					lowSurrogate = digit < 0 ? 0U : (lowSurrogate << 4) | static_cast<uint32_t>(digit);
+				}
+				if (lowSurrogate >= 0xDC00U && lowSurrogate <= 0xDFFFU)
+				{
+					codePoint = 0x10000U + ((codePoint - 0xD800U) << 10) + (lowSurrogate - 0xDC00U);
+					m_position += 6U;
+				}
+			}
+			AppendUtf8(m_decodedString, codePoint);
+		}
+		break;
+		default:
+			SetError();
+			return false;
+		}
+	}
+
+	SetError();
+	return false;
+}
+
+bool JsonReader::ReadNumberToken(const char*& begin, const char*& end, bool& isInteger)
+{
+	SkipWhitespace();
+	const size_t start = m_position;
+	isInteger = true;
+
+	if (m_position < m_size && m_data[m_position] == '-')
+	{
+		++m_position;
+	}
+
+	const size_t integerStart = m_position;
+	while (m_position < m_size && IsDigit(m_data[m_position]))
+	{
+		++m_position;
+	}
+	if (m_position == integerStart)
+	{
+		SetError();
+		return false;
+	}
+
+	if (m_position < m_size && m_data[m_position] == '.')
+	{
+		isInteger = false;
+		const size_t fractionStart = ++m_position;
+		while (m_position < m_size && IsDigit(m_data[m_position]))
+		{
+			++m_position;
+		}
+		if (m_position == fractionStart)
+		{
+			SetError();
+			return false;
+		}
+	}
+
+	if (m_position < m_size && (m_data[m_position] == 'e' || m_data[m_position] == 'E'))
+	{
+		isInteger = false;
+		++m_position;
+		if (m_position < m_size && (m_data[m_position] == '+' || m_data[m_position] == '-'))
+		{
+			++m_position;
+		}
+		const size_t exponentStart = m_position;
+		while (m_position < m_size && IsDigit(m_data[m_position]))
+		{
+			++m_position;
+		}
+		if (m_position == exponentStart)
+		{
+			SetError();
+			return false;
+		}
+	}
+
+	begin = m_data + start;
+	end = m_data + m_position;
+	return true;
+}
+
+bool JsonReader::ReadLiteral(const char* literal, const size_t length)
+{
+	SkipWhitespace();
+	if (m_position + length <= m_size && std::memcmp(m_data + m_position, literal, length) == 0)
+	{
+		m_position += length;
+		return true;
+	}
+	return false;
+}
+
+int64_t JsonReader::ReadInt()
+{
+	if (ReadNull())
+	{
+		return 0;
+	}
+
+	const size_t start = m_position;
+	const char* begin = nullptr;
+	const char* end = nullptr;
+	bool isInteger = false;
+	if (!ReadNumberToken(begin, end, isInteger))
+	{
+		return 0;
+	}
+
+	const bool isNegative = *begin == '-';
+	const uint64_t maxMagnitude = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + (isNegative ? 1U : 0U);
+	uint64_t magnitude = 0U;
+	if (!isInteger || !ParseDigits(isNegative ? begin + 1 : begin, end, magnitude) || magnitude > maxMagnitude)
+	{
+		// Out of range and fractional values are converted from double and clamped
+		m_position = start;
+		return ClampToInt64(ReadDouble());
+	}
+
+	// Negate in unsigned arithmetic, so the minimal value does not overflow
+	return static_cast<int64_t>(isNegative ? 0U - magnitude : magnitude);
+}
+
+uint64_t JsonReader::ReadUInt()
+{
+	if (ReadNull())
+	{
+		return 0U;
+	}
+
+	const size_t start = m_position;
+	const char* begin = nullptr;
+	const char* end = nullptr;
+	bool isInteger = false;
+	if (!ReadNumberToken(begin, end, isInteger))
+	{
+		return 0U;
+	}
+
+	uint64_t value = 0U;
+	if (*begin == '-' || !isInteger || !ParseDigits(begin, end, value))
+	{
+		// Negative, out of range and fractional values are converted from double and clamped
+		m_position = start;
+		return ClampToUInt64(ReadDouble());
+	}
+	return value;
+}
+
+double JsonReader::ReadDouble()
+{
+	if (ReadNull())
+	{
+		// NaN and infinities are written as null
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+
+	const char* begin = nullptr;
+	const char* end = nullptr;
+	bool isInteger = false;
+	if (!ReadNumberToken(begin, end, isInteger))
+	{
+		return 0.0;
+	}
+
+	// Mantissa and decimal exponent, while all the significant digits fit into 64 bits
+	const char* it = begin;
+	const bool isNegative = *it == '-';
+	if (isNegative)
+	{
+		++it;
+	}
+
+	uint64_t mantissa = 0U;
+	int exponent = 0;
+	int significantDigits = 0;
+	for (; it != end && IsDigit(*it); ++it)
+	{
+		mantissa = mantissa * 10U + static_cast<uint64_t>(*it - '0');
+		significantDigits += mantissa != 0U ? 1 : 0;
+	}
+	if (it != end && *it == '.')
+	{
+		for (++it; it != end && IsDigit(*it); ++it)
+		{
+			mantissa = mantissa * 10U + static_cast<uint64_t>(*it - '0');
+			significantDigits += mantissa != 0U ? 1 : 0;
+			--exponent;
+		}
+	}
+	if (it != end)
+	{
+		// Exponent part
+		++it;
+		const bool isExponentNegative = *it == '-';
+		if (*it == '-' || *it == '+')
+		{
+			++it;
+		}
+		int explicitExponent = 0;
+		for (; it != end && explicitExponent < 10000; ++it)
+		{
+			explicitExponent = explicitExponent * 10 + (*it - '0');
+		}
+		exponent += isExponentNegative ? -explicitExponent : explicitExponent;
+	}
+
+	// Both the mantissa and the power of ten are exact, so a single
+	// multiplication or division gives the correctly rounded result
+	const uint64_t maxExactMantissa = uint64_t(1) << 53;
+	if (significantDigits <= 19 && mantissa <= maxExactMantissa && exponent >= -22 && exponent <= 22)
+	{
+		double value = static_cast<double>(mantissa);
+		value = exponent < 0 ? value / exactPowersOf10[-exponent] : value * exactPowersOf10[exponent];
+		return isNegative ? -value : value;
+	}
+
+	// Rare long or large numbers, the classic locale keeps the point as the separator
+	std::istringstream token(std::string(begin, end));
+	token.imbue(std::locale::classic());
+	double value = 0.0;
+	token >> value;
+	return value;
+}
+
+bool JsonReader::ReadBool()
+{
+	if (ReadLiteral("true", 4U))
+	{
+		return true;
+	}
+	if (!ReadLiteral("false", 5U))
+	{
+		SetError();
+	}
+	return false;
+}
+
+void JsonReader::ReadString(std::string& value)
+{
+	const char* data = nullptr;
+	size_t length = 0U;
+	if (ReadStringToken(data, length))
+	{
+		value.assign(data, length);
+	}
+}
+
+bool JsonReader::ReadNull()
+{
+	return ReadLiteral("null", 4U);
+}
+
+void JsonReader::SkipValue()
+{
+	switch (PeekValue())
+	{
+	case ValueType::Object:
+	{
+		BeginObject();
+		const char* name = nullptr;
+		size_t length = 0U;
+		while (NextMember(name, length))
+		{
+			SkipValue();
+		}
+	}
+	break;
+	case ValueType::Array:
+	{
+		BeginArray();
+		while (NextElement())
+		{
+			SkipValue();
+		}
+	}
+	break;
+	case ValueType::String:
+	{
+		const char* value = nullptr;
+		size_t length = 0U;
+		ReadStringToken(value, length);
+	}
+	break;
+	case ValueType::Number:
+	{
+		const char* begin = nullptr;
+		const char* end = nullptr;
+		bool isInteger = false;
+		ReadNumberToken(begin, end, isInteger);
+	}
+	break;
+	case ValueType::Bool:
+		ReadBool();
+		break;
+	case ValueType::Null:
+		if (!ReadNull())
+		{
+			SetError();
+		}
+		break;
+	default:
+		SetError();
+		break;
+	}
+}
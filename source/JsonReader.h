@@ -0,0 +1,95 @@
+#ifndef JSON_READER_INCLUDE
+#define JSON_READER_INCLUDE
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Pull parser over a JSON document kept in memory. Values are read one by one
+// in document order, nothing is stored except the nesting of open scopes.
+// Malformed input puts the reader into the error state, in which every read
+// returns a default value and every scope appears empty.
+class JsonReader
+{
+public:
+	enum class ValueType
+	{
+		None,
+		Object,
+		Array,
+		String,
+		Number,
+		Bool,
+		Null
+	};
+
+	JsonReader() = default;
+	JsonReader(const char* data, const size_t size) { SetInput(data, size); }
+
+	// The data is not copied and must outlive the reader
+	void SetInput(const char* data, const size_t size);
+
+	ValueType PeekValue();
+
+	bool BeginObject();
+	// Returns false and leaves the object when there are no more members.
+	// The name stays valid until the next read.
+	bool NextMember(const char*& name, size_t& length);
+
+	bool BeginArray();
+	// Returns false and leaves the array when there are no more elements
+	bool NextElement();
+
+	// Fractional values are truncated, values out of range are clamped
+	int64_t ReadInt();
+	uint64_t ReadUInt();
+	double ReadDouble();
+	bool ReadBool();
+	void ReadString(std::string& value);
+	bool ReadNull();
+
+	void SkipValue();
+
+	static constexpr size_t InvalidPosition = static_cast<size_t>(-1);
+
+	// Allows to return to a value seen before. A single value may be read again from
+	// any scope, but members and elements only continue in the scope they came from.
+	size_t GetPosition() const { return m_position; }
+	void SetPosition(const size_t position) { m_position = position; }
+
+	bool HasError() const { return m_hasError; }
+
+private:
+	void SkipWhitespace()
+	{
+		while (m_position < m_size)
+		{
+			const char c = m_data[m_position];
+			if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+			{
+				break;
+			}
+			++m_position;
+		}
+	}
+
+	bool Expect(const char c);
+	bool NextInScope(const char closing);
+	void SetError();
+
+	bool ReadStringToken(const char*& value, size_t& length);
+	bool ReadNumberToken(const char*& begin, const char*& end, bool& isInteger);
+	bool ReadLiteral(const char* literal, const size_t length);
+
+	const char* m_data = nullptr;
+	size_t m_size = 0U;
+	size_t m_position = 0U;
+
+	// One entry per open object or array, true when its first element was read
+	std::vector<bool> m_scopes;
+	// Strings with escape sequences are decoded here
+	std::string m_decodedString;
+	bool m_hasError = false;
+};
+
+#endif
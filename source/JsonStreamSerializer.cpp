@@ -0,0 +1,606 @@
+#include "JsonStreamSerializer.h"
+
+JsonStreamSerializer::JsonStreamSerializer(JsonOutputSink& sink) : m_writer(new JsonWriter(sink))
+{
+}
+
+JsonStreamSerializer::JsonStreamSerializer(const char* data, const size_t size) : m_reader(data, size)
+{
+}
+
+JsonStreamSerializer::~JsonStreamSerializer()
+{
+	Finish();
+}
+
+void JsonStreamSerializer::Clear()
+{
+	Finish();
+	Serializer::Clear();
+	m_pointerRecords.clear();
+}
+
+void JsonStreamSerializer::BeginDocument()
+{
+	assert(m_writer && "The serializer was created for reading");
+	if (!m_isDocumentOpen)
+	{
+		assert(!m_writer->IsComplete() && "Only one document can be written");
+		m_writer->BeginObject();
+		m_isDocumentOpen = true;
+	}
+}
+
+void JsonStreamSerializer::Finish()
+{
+	if (m_isDocumentOpen)
+	{
+		m_writer->EndObject();
+		m_isDocumentOpen = false;
+	}
+	if (m_writer)
+	{
+		m_writer->Flush();
+	}
+}
+
+bool JsonStreamSerializer::FindRootMember(const std::string& name)
+{
+	if (!m_isReadingDocument)
+	{
+		m_reader.BeginObject();
+		m_isReadingDocument = true;
+	}
+
+	const char* memberName = nullptr;
+	size_t length = 0U;
+	while (m_reader.NextMember(memberName, length))
+	{
+		if (length == name.size() && std::memcmp(memberName, name.data(), length) == 0)
+		{
+			return true;
+		}
+		m_reader.SkipValue();
+	}
+	return false;
+}
+
+void JsonStreamSerializer::SerializePointers()
+{
+	BeginDocument();
+
+	m_writer->Key("pointers", 8U);
+	m_writer->BeginArray();
+
+	// Pointed-to objects may contain pointers themselves, so keep going
+	// until no new addresses were discovered
+	while (!m_pointersToSerialize.empty())
+	{
+		auto pointersToSerialize = std::move(m_pointersToSerialize);
+		m_pointersToSerialize.clear();
+
+		for (auto& it : pointersToSerialize)
+		{
+			m_serializedPointers.insert(it.first);
+		}
+
+		for (auto& it : pointersToSerialize)
+		{
+			auto valueAddress = it.first;
+			auto typeInfo = it.second;
+			auto actualTypeInfo = typeInfo->pointerParams.getActualTypeInfo(valueAddress);
+
+			m_writer->BeginObject();
+			m_writer->Key("address", 7U);
+			m_writer->UInt(reinterpret_cast<uintptr_t>(valueAddress));
+			m_writer->Key("type", 4U);
+			m_writer->String(actualTypeInfo->GetName());
+			m_writer->Key("value", 5U);
+			SerializeByType(*actualTypeInfo, valueAddress);
+			m_writer->EndObject();
+		}
+	}
+
+	m_writer->EndArray();
+}
+
+void JsonStreamSerializer::SerializeInternal(const ObjectDesc& objectDesc, void* object)
+{
+	BeginDocument();
+
+	auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const auto planIndex = plans.GetPlanIndex(objectDesc.GetId());
+
+	m_writer->Key(objectDesc.GetName());
+	SerializePlan(planIndex, object);
+}
+
+void JsonStreamSerializer::DeserializeInternal(const ObjectDesc& objectDesc, void* object)
+{
+	if (FindRootMember(objectDesc.GetName()))
+	{
+		auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+		DeserializePlan(plans.GetPlanIndex(objectDesc.GetId()), object);
+	}
+}
+
+void JsonStreamSerializer::DeserializePointers()
+{
+	if (!FindRootMember("pointers"))
+	{
+		return;
+	}
+
+	auto& typeInfoCollection = TypeInfoCollection::GetInstance();
+
+	// Index the whole section first: a record may be referenced by an object stored before it
+	m_reader.BeginArray();
+	while (m_reader.NextElement())
+	{
+		uintptr_t address = 0U;
+		PointerRecord record;
+		bool hasValue = false;
+
+		m_reader.BeginObject();
+		const char* name = nullptr;
+		size_t length = 0U;
+		while (m_reader.NextMember(name, length))
+		{
+			const std::string memberName(name, length);
+			if (memberName == "address")
+			{
+				address = static_cast<uintptr_t>(m_reader.ReadUInt());
+			}
+			else if (memberName == "type")
+			{
+				std::string typeName;
+				m_reader.ReadString(typeName);
+				record.typeInfo = typeInfoCollection.GetTypeInfo(typeName);
+			}
+			else
+			{
+				if (memberName == "value")
+				{
+					record.valuePosition = m_reader.GetPosition();
+					hasValue = true;
+				}
+				m_reader.SkipValue();
+			}
+		}
+
+		if (address != 0U && record.typeInfo != nullptr && hasValue)
+		{
+			m_pointerRecords[address] = record;
+		}
+	}
+	const size_t sectionEnd = m_reader.GetPosition();
+
+	while (!m_pointersToDeserialize.empty())
+	{
+		auto pointersToDeserialize = std::move(m_pointersToDeserialize);
+		m_pointersToDeserialize.clear();
+
+		for (auto& it : pointersToDeserialize)
+		{
+			auto findIt = m_pointerRecords.find(it.first);
+			if (findIt == m_pointerRecords.end())
+			{
+				continue;
+			}
+
+			auto& record = findIt->second;
+			if (record.object == nullptr)
+			{
+				record.object = record.typeInfo->CreateValue(m_objectAllocator);
+
+				m_reader.SetPosition(record.valuePosition);
+				DeserializeByType(*record.typeInfo, record.object);
+			}
+
+			for (auto dataAddress : it.second)
+			{
+				*reinterpret_cast<void**>(dataAddress) = record.object;
+			}
+		}
+	}
+
+	m_reader.SetPosition(sectionEnd);
+}
+
+void JsonStreamSerializer::SerializePlan(const size_t planIndex, void* object)
+{
+	const auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const auto& plan = plans.GetPlan(planIndex);
+	const SerializationStep* steps = plans.GetSteps(plan);
+
+	m_writer->BeginObject();
+	for (size_t i = 0U; i < plan.stepsCount; ++i)
+	{
+		const auto& step = steps[i];
+		TempStack::Scope tempScope(m_tempStack);
+		void* data = step.GetData(object, m_tempStack);
+
+		m_writer->Key(step.property->GetName());
+		SerializeByType(*step.typeInfo, data, step.nestedPlanIndex);
+	}
+	m_writer->EndObject();
+}
+
+void JsonStreamSerializer::DeserializePlan(const size_t planIndex, void* object)
+{
+	const auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+	const auto& plan = plans.GetPlan(planIndex);
+	const SerializationStep* steps = plans.GetSteps(plan);
+
+	if (!m_reader.BeginObject())
+	{
+		return;
+	}
+
+	const char* name = nullptr;
+	size_t length = 0U;
+	while (m_reader.NextMember(name, length))
+	{
+		const size_t stepIndex = plans.FindStep(plan, name, length);
+		if (stepIndex == SerializationPlans::InvalidIndex)
+		{
+			// Property was removed or renamed since the document was written
+			m_reader.SkipValue();
+			continue;
+		}
+
+		const auto& step = steps[stepIndex];
+		TempStack::Scope tempScope(m_tempStack);
+		void* data = step.GetData(object, m_tempStack);
+
+		DeserializeByType(*step.typeInfo, data, step.nestedPlanIndex);
+
+		// Direct fields were written in place, only accessors need to be called
+		if (!step.IsDirectField())
+		{
+			step.MoveValue(object, data);
+		}
+	}
+}
+
+void JsonStreamSerializer::SerializeByType(const TypeInfo& typeInfo, void* data, size_t planIndex)
+{
+	switch (typeInfo.type)
+	{
+	case TypeInfo::Fundamental:
+	case TypeInfo::Enum:
+	{
+		const auto& codec = GetBasicTypeCodec(typeInfo);
+		BasicValue value;
+		codec.load(data, value);
+
+		switch (codec.category)
+		{
+		case BasicTypeCategory::Signed:
+			m_writer->Int(value.signedValue);
+			break;
+		case BasicTypeCategory::Unsigned:
+			m_writer->UInt(value.unsignedValue);
+			break;
+		case BasicTypeCategory::Floating:
+			if (codec.size == sizeof(float))
+			{
+				m_writer->Float(static_cast<float>(value.floatingValue));
+			}
+			else
+			{
+				m_writer->Double(value.floatingValue);
+			}
+			break;
+		case BasicTypeCategory::Bool:
+			m_writer->Bool(value.boolValue);
+			break;
+		default:
+			m_writer->Null();
+			break;
+		}
+	}
+	break;
+	case TypeInfo::Class:
+	{
+		if (planIndex == SerializationPlans::InvalidIndex)
+		{
+			auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+			planIndex = plans.GetPlanIndex(typeInfo.GetObjectDescId());
+		}
+		SerializePlan(planIndex, data);
+	}
+	break;
+	case TypeInfo::String:
+	{
+		auto str = reinterpret_cast<std::string*>(data);
+		m_writer->String(*str);
+	}
+	break;
+	case TypeInfo::View:
+	{
+		auto view = reinterpret_cast<ArchiveViewData*>(data);
+		const TypeInfo& elementTypeInfo = *typeInfo.viewParams.elementTypeInfo;
+		const size_t elementSize = typeInfo.viewParams.elementSize;
+		const char* elements = reinterpret_cast<const char*>(view->GetData());
+		if (elementTypeInfo.type == TypeInfo::Fundamental && elementTypeInfo.fundamentalTypeParams.typeIndex == BT_CHAR)
+		{
+			m_writer->String(elements, view->GetBytesCount());
+			break;
+		}
+
+		// Elements are copied out one by one, they may be unaligned
+		TempStack::Scope tempScope(m_tempStack);
+		TempContainer& element = m_tempStack.Push();
+		m_writer->BeginArray();
+		for (size_t offset = 0U; offset < view->GetBytesCount(); offset += elementSize)
+		{
+			element.SetData(elements + offset, elementSize);
+			SerializeByType(elementTypeInfo, element.GetData());
+		}
+		m_writer->EndArray();
+	}
+	break;
+	case TypeInfo::Pointer:
+	{
+		void* actualPtr = *reinterpret_cast<void**>(data);
+		if (actualPtr != nullptr)
+		{
+			const bool isNotSerializedYet = m_serializedPointers.find(actualPtr) == m_serializedPointers.end();
+			const bool isNotWaitingForSerialization = m_pointersToSerialize.find(actualPtr) == m_pointersToSerialize.end();
+			if (isNotSerializedYet && isNotWaitingForSerialization)
+			{
+				auto underlyingTypeInfo = typeInfo.pointerParams.underlyingType;
+				m_pointersToSerialize[actualPtr] = underlyingTypeInfo;
+			}
+			m_writer->UInt(reinterpret_cast<uintptr_t>(actualPtr));
+		}
+		else
+		{
+			m_writer->Null();
+		}
+	}
+	break;
+	case TypeInfo::Array:
+	{
+		size_t elementsCount = 0U;
+		const auto& elementTypeInfo = typeInfo.arrayParams.elementTypeInfo;
+
+		if (typeInfo.arrayParams.arrayType == TypeInfo::ArrayType::Vector)
+		{
+			elementsCount = typeInfo.arrayParams.getSize(data);
+		}
+		else
+		{
+			elementsCount = typeInfo.arrayParams.elementsCount;
+		}
+
+		m_writer->BeginArray();
+		for (size_t i = 0U; i < elementsCount; ++i)
+		{
+			void* currentDataAddress = typeInfo.arrayParams.getItem(data, i);
+			SerializeByType(*elementTypeInfo, currentDataAddress, planIndex);
+		}
+		m_writer->EndArray();
+	}
+	break;
+	case TypeInfo::Map:
+	{
+		m_writer->BeginArray();
+
+		TypeInfo::MapParams::IteratorStorage iteratorStorage;
+		typeInfo.mapParams.initIterator(data, iteratorStorage);
+		void* it = iteratorStorage.data;
+		while (typeInfo.mapParams.isIteratorValid(it, data))
+		{
+			m_writer->BeginObject();
+
+			m_writer->Key("key", 3U);
+			auto key = typeInfo.mapParams.getKey(it);
+			SerializeByType(*typeInfo.mapParams.keyTypeInfo, const_cast<void*>(key));
+
+			m_writer->Key("value", 5U);
+			auto value = typeInfo.mapParams.getValue(it);
+			SerializeByType(*typeInfo.mapParams.valueTypeInfo, value);
+
+			m_writer->EndObject();
+
+			typeInfo.mapParams.incrementIterator(it);
+		}
+
+		m_writer->EndArray();
+	}
+	break;
+	default:
+		m_writer->Null();
+		break;
+	}
+}
+
+void JsonStreamSerializer::DeserializeByType(const TypeInfo& typeInfo, void* data, size_t planIndex)
+{
+	switch (typeInfo.type)
+	{
+	case TypeInfo::Fundamental:
+	case TypeInfo::Enum:
+	{
+		const auto& codec = GetBasicTypeCodec(typeInfo);
+		BasicValue value;
+
+		switch (codec.category)
+		{
+		case BasicTypeCategory::Signed:
+			value.signedValue = m_reader.ReadInt();
+			break;
+		case BasicTypeCategory::Unsigned:
+			value.unsignedValue = m_reader.ReadUInt();
+			break;
+		case BasicTypeCategory::Floating:
+			value.floatingValue = m_reader.ReadDouble();
+			break;
+		case BasicTypeCategory::Bool:
+			value.boolValue = m_reader.ReadBool();
+			break;
+		default:
+			m_reader.SkipValue();
+			break;
+		}
+
+		codec.store(data, value);
+	}
+	break;
+	case TypeInfo::Class:
+	{
+		if (planIndex == SerializationPlans::InvalidIndex)
+		{
+			auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+			planIndex = plans.GetPlanIndex(typeInfo.GetObjectDescId());
+		}
+		DeserializePlan(planIndex, data);
+	}
+	break;
+	case TypeInfo::String:
+	{
+		auto str = reinterpret_cast<std::string*>(data);
+		m_reader.ReadString(*str);
+	}
+	break;
+	case TypeInfo::View:
+		// Text holds no bytes a view could refer to, views are only read from binary archives
+		m_reader.SkipValue();
+		break;
+	case TypeInfo::Pointer:
+	{
+		const uintptr_t v = static_cast<uintptr_t>(m_reader.ReadUInt());
+		if (v != 0U)
+		{
+			m_pointersToDeserialize[v].push_back(data);
+		}
+	}
+	break;
+	case TypeInfo::Array:
+	{
+		const auto& elementTypeInfo = typeInfo.arrayParams.elementTypeInfo;
+		const bool isVector = typeInfo.arrayParams.arrayType == TypeInfo::ArrayType::Vector;
+
+		// Elements holding pointers are kept as pointer slots and must not move, such vectors
+		// are sized once before reading. Counting skips the elements and returns to the array.
+		// Other vectors grow as elements are read, so nested arrays are scanned only once.
+		const auto& plans = ObjectFactory::GetInstance().GetSerializationPlans();
+		const bool isSizedFirst = isVector && plans.HasPointers(*elementTypeInfo);
+		if (isSizedFirst)
+		{
+			const size_t arrayPosition = m_reader.GetPosition();
+			if (!m_reader.BeginArray())
+			{
+				break;
+			}
+			size_t count = 0U;
+			while (m_reader.NextElement())
+			{
+				m_reader.SkipValue();
+				++count;
+			}
+			typeInfo.arrayParams.setSize(data, count);
+			m_reader.SetPosition(arrayPosition);
+		}
+
+		if (!m_reader.BeginArray())
+		{
+			break;
+		}
+
+		size_t elementsCount = 0U;
+		while (m_reader.NextElement())
+		{
+			if (isVector && !isSizedFirst)
+			{
+				typeInfo.arrayParams.setSize(data, elementsCount + 1U);
+			}
+			else if (!isVector && elementsCount == typeInfo.arrayParams.elementsCount)
+			{
+				m_reader.SkipValue();
+				continue;
+			}
+
+			void* currentDataAddress = typeInfo.arrayParams.getItem(data, elementsCount);
+			DeserializeByType(*elementTypeInfo, currentDataAddress, planIndex);
+			++elementsCount;
+		}
+
+		// An empty array still has to clear a grown vector
+		if (isVector && !isSizedFirst && elementsCount == 0U)
+		{
+			typeInfo.arrayParams.setSize(data, 0U);
+		}
+	}
+	break;
+	case TypeInfo::Map:
+	{
+		const TypeInfo& keyTypeInfo = *typeInfo.mapParams.keyTypeInfo;
+		const TypeInfo& valueTypeInfo = *typeInfo.mapParams.valueTypeInfo;
+
+		// Values are read straight into the map nodes, so pointer slots refer to the map
+		typeInfo.mapParams.clear(data);
+
+		TempStack::Scope scope(m_tempStack);
+		TempContainer& keyContainer = m_tempStack.Push();
+
+		if (m_reader.BeginArray())
+		{
+			while (m_reader.NextElement())
+			{
+				// Every key is read into a freshly constructed value
+				void* keyBuffer = keyContainer.Construct(keyTypeInfo.size, keyTypeInfo.alignment,
+					keyTypeInfo.constructValue, keyTypeInfo.destructValue);
+				void* value = nullptr;
+				bool hasKey = false;
+				// A value met before its key is read once the key is known
+				size_t valuePosition = JsonReader::InvalidPosition;
+
+				m_reader.BeginObject();
+				const char* name = nullptr;
+				size_t length = 0U;
+				while (m_reader.NextMember(name, length))
+				{
+					if (length == 3U && std::memcmp(name, "key", 3U) == 0 && !hasKey)
+					{
+						DeserializeByType(keyTypeInfo, keyBuffer);
+						hasKey = true;
+					}
+					else if (length == 5U && std::memcmp(name, "value", 5U) == 0 && hasKey)
+					{
+						value = typeInfo.mapParams.emplaceValue(data, keyBuffer);
+						DeserializeByType(valueTypeInfo, value);
+					}
+					else if (length == 5U && std::memcmp(name, "value", 5U) == 0)
+					{
+						valuePosition = m_reader.GetPosition();
+						m_reader.SkipValue();
+					}
+					else
+					{
+						m_reader.SkipValue();
+					}
+				}
+
+				if (value == nullptr)
+				{
+					value = typeInfo.mapParams.emplaceValue(data, keyBuffer);
+					if (valuePosition != JsonReader::InvalidPosition)
+					{
+						const size_t position = m_reader.GetPosition();
+						m_reader.SetPosition(valuePosition);
+						DeserializeByType(valueTypeInfo, value);
+						m_reader.SetPosition(position);
+					}
+				}
+			}
+		}
+	}
+	break;
+	default:
+		m_reader.SkipValue();
+		break;
+	}
+}
@@ -0,0 +1,63 @@
+#ifndef JSON_STREAM_SERIALIZER_INCLUDE
+#define JSON_STREAM_SERIALIZER_INCLUDE
+
+#include "Serializer.h"
+#include "JsonWriter.h"
+#include "JsonReader.h"
+#include "BasicTypeCodec.h"
+
+// Writes the same document layout as the jsoncpp based JsonSerializer, but emits
+// it token by token while walking the objects, without building a DOM first.
+// The root object is opened by the first serialized object and closed by Finish.
+// Reading pulls values straight into the objects, so objects must be
+// deserialized in the same order they were serialized.
+class JsonStreamSerializer : public Serializer
+{
+public:
+	// Writing serializer
+	explicit JsonStreamSerializer(JsonOutputSink& sink);
+	// Reading serializer, the document is not copied and must outlive the serializer
+	JsonStreamSerializer(const char* data, const size_t size);
+	~JsonStreamSerializer() override;
+
+	void Clear() override;
+
+	void SerializePointers() override;
+	void DeserializePointers() override;
+
+	bool HasError() const { return m_reader.HasError(); }
+
+	// Closes the document and writes everything to the sink
+	void Finish();
+
+protected:
+	void SerializeInternal(const ObjectDesc& objectDesc, void* object) override final;
+	void DeserializeInternal(const ObjectDesc& objectDesc, void* object) override final;
+
+	void SerializePlan(const size_t planIndex, void* object);
+	void DeserializePlan(const size_t planIndex, void* object);
+
+	void SerializeByType(const TypeInfo& typeInfo, void* data, size_t planIndex = SerializationPlans::InvalidIndex);
+	void DeserializeByType(const TypeInfo& typeInfo, void* data, size_t planIndex = SerializationPlans::InvalidIndex);
+
+private:
+	void BeginDocument();
+	// Moves the reader to the value of the next root member with the given name
+	bool FindRootMember(const std::string& name);
+
+	std::unique_ptr<JsonWriter> m_writer;
+	bool m_isDocumentOpen = false;
+
+	JsonReader m_reader;
+	bool m_isReadingDocument = false;
+
+	struct PointerRecord
+	{
+		const TypeInfo* typeInfo = nullptr;
+		size_t valuePosition = 0U;
+		void* object = nullptr;
+	};
+	std::unordered_map<uintptr_t, PointerRecord> m_pointerRecords;
+};
+
+#endif
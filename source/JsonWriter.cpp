@@ -0,0 +1,307 @@
+#include "JsonWriter.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+constexpr size_t JsonWriter::BufferSize;
+
+// Escape character for every byte: 0 - written as is, 'u' - written as \u00XX
+struct EscapeTable
+{
+	EscapeTable()
+	{
+		for (int i = 0; i < 0x20; ++i)
+		{
+			table[i] = 'u';
+		}
+		table[static_cast<unsigned char>('\b')] = 'b';
+		table[static_cast<unsigned char>('\f')] = 'f';
+		table[static_cast<unsigned char>('\n')] = 'n';
+		table[static_cast<unsigned char>('\r')] = 'r';
+		table[static_cast<unsigned char>('\t')] = 't';
+		table[static_cast<unsigned char>('"')] = '"';
+		table[static_cast<unsigned char>('\\')] = '\\';
+	}
+
+	char table[256] = {};
+};
+
+static const EscapeTable escapeTable;
+
+static const char digitPairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+// Writes the digits backwards from the end of the buffer, two at a time
+static char* FormatUInt(uint64_t value, char* end)
+{
+	char* position = end;
+	while (value >= 100U)
+	{
+		const size_t pair = static_cast<size_t>(value % 100U) * 2U;
+		value /= 100U;
+		*--position = digitPairs[pair + 1U];
+		*--position = digitPairs[pair];
+	}
+	if (value >= 10U)
+	{
+		const size_t pair = static_cast<size_t>(value) * 2U;
+		*--position = digitPairs[pair + 1U];
+		*--position = digitPairs[pair];
+	}
+	else
+	{
+		*--position = static_cast<char>('0' + value);
+	}
+	return position;
+}
+
+JsonWriter::JsonWriter(JsonOutputSink& sink) : m_sink(sink)
+{
+	m_buffer.resize(BufferSize);
+}
+
+JsonWriter::~JsonWriter()
+{
+	Flush();
+}
+
+void JsonWriter::Flush()
+{
+	if (m_size > 0U)
+	{
+		m_sink.Write(m_buffer.data(), m_size);
+		m_size = 0U;
+	}
+}
+
+void JsonWriter::Put(const char* data, size_t size)
+{
+	if (m_size + size > BufferSize)
+	{
+		Flush();
+		if (size > BufferSize)
+		{
+			m_sink.Write(data, size);
+			return;
+		}
+	}
+	std::memcpy(m_buffer.data() + m_size, data, size);
+	m_size += size;
+}
+
+void JsonWriter::BeginValue()
+{
+	if (m_isAfterKey)
+	{
+		m_isAfterKey = false;
+		return;
+	}
+
+	if (m_scopes.empty())
+	{
+		assert(!m_hasRootValue && "Only one root value is allowed");
+		m_hasRootValue = true;
+		return;
+	}
+
+	if (m_scopes.back())
+	{
+		Put(',');
+	}
+	else
+	{
+		m_scopes.back() = true;
+	}
+}
+
+void JsonWriter::BeginObject()
+{
+	BeginValue();
+	Put('{');
+	m_scopes.push_back(false);
+}
+
+void JsonWriter::EndObject()
+{
+	assert(!m_scopes.empty() && !m_isAfterKey);
+	m_scopes.pop_back();
+	Put('}');
+}
+
+void JsonWriter::BeginArray()
+{
+	BeginValue();
+	Put('[');
+	m_scopes.push_back(false);
+}
+
+void JsonWriter::EndArray()
+{
+	assert(!m_scopes.empty() && !m_isAfterKey);
+	m_scopes.pop_back();
+	Put(']');
+}
+
+void JsonWriter::Key(const char* name, const size_t length)
+{
+	assert(!m_scopes.empty() && !m_isAfterKey);
+	BeginValue();
+	WriteEscaped(name, length);
+	Put(':');
+	m_isAfterKey = true;
+}
+
+void JsonWriter::Int(const int64_t value)
+{
+	BeginValue();
+
+	char digits[24];
+	char* end = digits + sizeof(digits);
+	// Negate in unsigned arithmetic, so the minimal value does not overflow
+	const uint64_t magnitude = value < 0 ? 0U - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+	char* begin = FormatUInt(magnitude, end);
+	if (value < 0)
+	{
+		*--begin = '-';
+	}
+	Put(begin, static_cast<size_t>(end - begin));
+}
+
+void JsonWriter::UInt(const uint64_t value)
+{
+	BeginValue();
+
+	char digits[24];
+	char* end = digits + sizeof(digits);
+	char* begin = FormatUInt(value, end);
+	Put(begin, static_cast<size_t>(end - begin));
+}
+
+void JsonWriter::Float(const float value)
+{
+	// 9 significant digits are enough to restore any float
+	WriteFloatingPoint(value, 9);
+}
+
+void JsonWriter::Double(const double value)
+{
+	// 17 significant digits are enough to restore any double
+	WriteFloatingPoint(value, 17);
+}
+
+void JsonWriter::WriteFloatingPoint(const double value, const int precision)
+{
+	if (!std::isfinite(value))
+	{
+		// JSON has no representation for NaN and infinities
+		Null();
+		return;
+	}
+
+	// Whole numbers are common in scene data and do not need the generic formatter
+	if (value == std::trunc(value) && std::fabs(value) < 1e15)
+	{
+		if (std::signbit(value) && value == 0.0)
+		{
+			// Negative zero would lose its sign as an integer
+			BeginValue();
+			Put("-0.0", 4U);
+			return;
+		}
+		Int(static_cast<int64_t>(value));
+		Put(".0", 2U);
+		return;
+	}
+
+	BeginValue();
+
+	char digits[32];
+	const int length = snprintf(digits, sizeof(digits), "%.*g", precision, value);
+	assert(length > 0 && length < static_cast<int>(sizeof(digits)));
+
+	// The decimal separator of the C locale may be a comma or several bytes, JSON needs a point
+	char* out = digits;
+	for (int i = 0; i < length; ++i)
+	{
+		const char c = digits[i];
+		if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == 'e')
+		{
+			*out++ = c;
+		}
+		else if (out == digits || out[-1] != '.')
+		{
+			*out++ = '.';
+		}
+	}
+	Put(digits, static_cast<size_t>(out - digits));
+}
+
+void JsonWriter::Bool(const bool value)
+{
+	BeginValue();
+	if (value)
+	{
+		Put("true", 4U);
+	}
+	else
+	{
+		Put("false", 5U);
+	}
+}
+
+void JsonWriter::Null()
+{
+	BeginValue();
+	Put("null", 4U);
+}
+
+void JsonWriter::String(const char* value, const size_t length)
+{
+	BeginValue();
+	WriteEscaped(value, length);
+}
+
+void JsonWriter::WriteEscaped(const char* value, const size_t length)
+{
+	Put('"');
+
+	// Copy runs of characters which need no escaping at once
+	size_t runStart = 0U;
+	for (size_t i = 0U; i < length; ++i)
+	{
+		const char escape = escapeTable.table[static_cast<unsigned char>(value[i])];
+		if (escape == 0)
+		{
+			continue;
+		}
+
+		Put(value + runStart, i - runStart);
+		runStart = i + 1U;
+
+		if (escape == 'u')
+		{
+			static const char hexDigits[] = "0123456789abcdef";
+			const unsigned char c = static_cast<unsigned char>(value[i]);
+			const char sequence[] = { '\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xF] };
+			Put(sequence, sizeof(sequence));
+		}
+		else
+		{
+			const char sequence[] = { '\\', escape };
+			Put(sequence, sizeof(sequence));
+		}
+	}
+	Put(value + runStart, length - runStart);
+
+	Put('"');
+}
@@ -0,0 +1,114 @@
+#ifndef JSON_WRITER_INCLUDE
+#define JSON_WRITER_INCLUDE
+
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Destination of the JsonWriter output
+class JsonOutputSink
+{
+public:
+	virtual ~JsonOutputSink() = default;
+
+	virtual void Write(const char* data, const size_t size) = 0;
+};
+
+class JsonStringSink : public JsonOutputSink
+{
+public:
+	explicit JsonStringSink(std::string& output) : m_output(output) {}
+
+	void Write(const char* data, const size_t size) override { m_output.append(data, size); }
+
+private:
+	std::string& m_output;
+};
+
+class JsonStreamSink : public JsonOutputSink
+{
+public:
+	explicit JsonStreamSink(std::ostream& stream) : m_stream(stream) {}
+
+	void Write(const char* data, const size_t size) override { m_stream.write(data, static_cast<std::streamsize>(size)); }
+
+private:
+	std::ostream& m_stream;
+};
+
+class JsonFileSink : public JsonOutputSink
+{
+public:
+	explicit JsonFileSink(FILE* file) : m_file(file) {}
+
+	void Write(const char* data, const size_t size) override { fwrite(data, 1U, size, m_file); }
+
+private:
+	FILE* m_file;
+};
+
+// Emits compact JSON tokens straight to a sink through a fixed size buffer,
+// so the memory used does not depend on the size of the document.
+// Commas and colons are placed automatically.
+class JsonWriter
+{
+public:
+	static constexpr size_t BufferSize = 64U * 1024U;
+
+	explicit JsonWriter(JsonOutputSink& sink);
+	~JsonWriter();
+
+	JsonWriter(const JsonWriter&) = delete;
+	JsonWriter& operator=(const JsonWriter&) = delete;
+
+	void BeginObject();
+	void EndObject();
+	void BeginArray();
+	void EndArray();
+
+	void Key(const char* name, const size_t length);
+	void Key(const std::string& name) { Key(name.data(), name.size()); }
+
+	void Int(const int64_t value);
+	void UInt(const uint64_t value);
+	void Float(const float value);
+	void Double(const double value);
+	void Bool(const bool value);
+	void Null();
+	void String(const char* value, const size_t length);
+	void String(const std::string& value) { String(value.data(), value.size()); }
+
+	// Writes the buffered output to the sink
+	void Flush();
+
+	bool IsComplete() const { return m_scopes.empty() && m_hasRootValue; }
+
+private:
+	void BeginValue();
+	void WriteFloatingPoint(const double value, const int precision);
+	void WriteEscaped(const char* value, const size_t length);
+
+	void Put(const char c)
+	{
+		if (m_size == BufferSize)
+		{
+			Flush();
+		}
+		m_buffer[m_size++] = c;
+	}
+
+	void Put(const char* data, size_t size);
+
+	JsonOutputSink& m_sink;
+	std::vector<char> m_buffer;
+	size_t m_size = 0U;
+
+	// One entry per open object or array, true when it already has an element
+	std::vector<bool> m_scopes;
+	bool m_isAfterKey = false;
+	bool m_hasRootValue = false;
+};
+
+#endif
@@ -0,0 +1,129 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	m_file = file;
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+	m_isOpen = true;
+
+	// Empty files can not be mapped, they are open with no data
+	if (m_size > 0U)
+	{
+		m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		m_data = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (m_data == nullptr)
+		{
+			Close();
+			return false;
+		}
+	}
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_data)
+	{
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mapping)
+	{
+		CloseHandle(m_mapping);
+	}
+	if (m_file)
+	{
+		CloseHandle(m_file);
+	}
+
+	m_data = nullptr;
+	m_mapping = nullptr;
+	m_file = nullptr;
+	m_size = 0U;
+	m_isOpen = false;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+
+	const int file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0)
+	{
+		close(file);
+		return false;
+	}
+
+	// Empty files can not be mapped, they are open with no data
+	void* data = nullptr;
+	const size_t size = static_cast<size_t>(fileStat.st_size);
+	if (size > 0U)
+	{
+		data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (data == MAP_FAILED)
+		{
+			close(file);
+			return false;
+		}
+	}
+	// The mapping stays valid without the descriptor
+	close(file);
+
+	m_data = data;
+	m_size = size;
+	m_isOpen = true;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_data)
+	{
+		munmap(const_cast<void*>(m_data), m_size);
+	}
+
+	m_data = nullptr;
+	m_size = 0U;
+	m_isOpen = false;
+}
+
+#endif
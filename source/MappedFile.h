@@ -0,0 +1,36 @@
+#ifndef MAPPED_FILE_INCLUDE
+#define MAPPED_FILE_INCLUDE
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file. Pages are loaded by the system when
+// they are first touched, so reading a part of the file does not load the rest.
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const std::string& path);
+	void Close();
+
+	bool IsOpen() const { return m_isOpen; }
+	const void* GetData() const { return m_data; }
+	size_t GetSize() const { return m_size; }
+
+private:
+	const void* m_data = nullptr;
+	size_t m_size = 0U;
+	bool m_isOpen = false;
+
+#if defined(_WIN32)
+	void* m_file = nullptr;
+	void* m_mapping = nullptr;
+#endif
+};
+
+#endif
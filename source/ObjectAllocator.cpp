@@ -0,0 +1,69 @@
+#include "ObjectAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+ObjectArena::ObjectArena(const size_t blockSize)
+	: m_blockSize(blockSize)
+{
+	assert(blockSize > 0U);
+}
+
+ObjectArena::~ObjectArena()
+{
+	Release();
+}
+
+void* ObjectArena::Allocate(const size_t size, const size_t alignment)
+{
+	assert(alignment > 0U && (alignment & (alignment - 1U)) == 0U);
+
+	uintptr_t address = (reinterpret_cast<uintptr_t>(m_current) + alignment - 1U) & ~(alignment - 1U);
+	if (m_current == nullptr || address + size > reinterpret_cast<uintptr_t>(m_end))
+	{
+		// Objects larger than a block get a block of their own
+		NextBlock(std::max(m_blockSize, size + alignment - 1U));
+		address = (reinterpret_cast<uintptr_t>(m_current) + alignment - 1U) & ~(alignment - 1U);
+	}
+
+	m_current = reinterpret_cast<char*>(address + size);
+	m_usedSize += size;
+	return reinterpret_cast<void*>(address);
+}
+
+void ObjectArena::AddDestructor(void* object, ValueDestructor destructor)
+{
+	m_destructors.emplace_back(object, destructor);
+}
+
+void ObjectArena::Release()
+{
+	for (auto it = m_destructors.rbegin(); it != m_destructors.rend(); ++it)
+	{
+		it->second(it->first);
+	}
+	m_destructors.clear();
+
+	m_blockIndex = 0U;
+	m_current = nullptr;
+	m_end = nullptr;
+	m_usedSize = 0U;
+}
+
+void ObjectArena::NextBlock(const size_t minSize)
+{
+	// Blocks of previous loads are reused before new ones are allocated
+	const size_t index = m_current ? m_blockIndex + 1U : m_blockIndex;
+	if (index == m_blocks.size() || m_blocks[index].size < minSize)
+	{
+		Block block;
+		block.data.reset(new char[minSize]);
+		block.size = minSize;
+		m_blocks.insert(m_blocks.begin() + index, std::move(block));
+	}
+
+	m_blockIndex = index;
+	m_current = m_blocks[index].data.get();
+	m_end = m_current + m_blocks[index].size;
+}
@@ -0,0 +1,80 @@
+#ifndef OBJECT_ALLOCATOR_INCLUDE
+#define OBJECT_ALLOCATOR_INCLUDE
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using ValueConstructor = void (*)(void* data);
+using ValueDestructor = void (*)(void* data);
+
+// Memory source for objects created during deserialization. Objects are never freed
+// one by one, the allocator destroys and frees all of them at once.
+class ObjectAllocator
+{
+public:
+	virtual ~ObjectAllocator() = default;
+
+	// Uninitialized memory, valid until the allocator is released
+	virtual void* Allocate(const size_t size, const size_t alignment) = 0;
+	// Registers an object to be destroyed when the allocator is released
+	virtual void AddDestructor(void* object, ValueDestructor destructor) = 0;
+
+	// Default constructs a value in allocated memory, nullptr when there is no constructor
+	void* Create(const size_t size, const size_t alignment, ValueConstructor constructor, ValueDestructor destructor)
+	{
+		if (constructor == nullptr)
+		{
+			return nullptr;
+		}
+
+		void* object = Allocate(size, alignment);
+		constructor(object);
+		if (destructor)
+		{
+			AddDestructor(object, destructor);
+		}
+		return object;
+	}
+};
+
+// Bump allocator, objects are placed one after another in large blocks.
+// Release destroys the objects in reverse creation order and keeps the blocks
+// for the next load, the memory is freed with the arena.
+class ObjectArena : public ObjectAllocator
+{
+public:
+	explicit ObjectArena(const size_t blockSize = 64U * 1024U);
+	~ObjectArena() override;
+
+	ObjectArena(const ObjectArena&) = delete;
+	ObjectArena& operator=(const ObjectArena&) = delete;
+
+	void* Allocate(const size_t size, const size_t alignment) override;
+	void AddDestructor(void* object, ValueDestructor destructor) override;
+
+	void Release();
+
+	// Bytes taken by objects since the last release
+	size_t GetUsedSize() const { return m_usedSize; }
+
+private:
+	void NextBlock(const size_t minSize);
+
+	struct Block
+	{
+		std::unique_ptr<char[]> data;
+		size_t size = 0U;
+	};
+
+	std::vector<Block> m_blocks;
+	size_t m_blockIndex = 0U;
+	std::vector<std::pair<void*, ValueDestructor>> m_destructors;
+	size_t m_blockSize = 0U;
+	char* m_current = nullptr;
+	char* m_end = nullptr;
+	size_t m_usedSize = 0U;
+};
+
+#endif
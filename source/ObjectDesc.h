@@ -5,12 +5,21 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <cassert>
+#include <cstddef>
+#include <deque>
+#include <new>
+#include <utility>
 
 class ConcreteObjectFactory
 {
 public:
+	virtual ~ConcreteObjectFactory() = default;
+
 	virtual void* CreateObject() = 0;
+	// The object is destroyed together with the allocator
+	virtual void* CreateObject(ObjectAllocator& allocator) = 0;
 };
 
 template<typename ObjectType>
@@ -19,11 +28,56 @@ class ConcreteObjectFactoryImpl : public ConcreteObjectFactory
 public:
 	void* CreateObject() override final
 	{
-		ObjectType* instance = new ObjectType();
-		return reinterpret_cast<void*>(instance);
+		void* instance = nullptr;
+		size_t size = 0U;
+		AllocateDefaultValue<ObjectType>(instance, size);
+		return instance;
+	}
+
+	void* CreateObject(ObjectAllocator& allocator) override final
+	{
+		return allocator.Create(sizeof(ObjectType), alignof(ObjectType),
+			GetValueConstructor<ObjectType>(), GetValueDestructor<ObjectType>());
 	}
 };
 
+// Converts a pointer to an object into a pointer to one of its virtual base subobjects
+using BaseCast = void* (*)(void* object);
+
+template<typename ObjectType, typename BaseObjectType>
+void* CastToBase(void* object)
+{
+	return static_cast<BaseObjectType*>(reinterpret_cast<ObjectType*>(object));
+}
+
+// Path from an object to the base subobject which declares an inherited property.
+// Every link is a constant offset, except for virtual bases where the offset depends
+// on the complete object and the link casts instead.
+struct BaseAdjustment
+{
+	void* Apply(void* object) const
+	{
+		void* base = cast ? cast(object) : reinterpret_cast<char*>(object) + offset;
+		return next ? next->Apply(base) : base;
+	}
+
+	// True when the whole path can be replaced with GetConstantOffset
+	bool IsConstant() const
+	{
+		return cast == nullptr && (next == nullptr || next->IsConstant());
+	}
+
+	ptrdiff_t GetConstantOffset() const
+	{
+		return offset + (next ? next->GetConstantOffset() : 0);
+	}
+
+	ptrdiff_t offset = 0;
+	BaseCast cast = nullptr;
+	// Path from the base subobject further, nullptr when the base declares the property
+	const BaseAdjustment* next = nullptr;
+};
+
 class ObjectDesc
 {
 public:
@@ -48,44 +102,127 @@ public:
 	template<typename ObjectType, typename FieldType>
 	ObjectDesc& AddProperty(const std::string& name, FieldType ObjectType::* fieldPointer)
 	{
-		auto findResult = m_properties.find(name);
-		assert(findResult == m_properties.end());
-
-		Property* prop = new FieldProperty<ObjectType, FieldType>(name, fieldPointer);
-
-		m_properties[name] = prop;
+		InsertProperty(CreateProperty<FieldProperty<ObjectType, FieldType>>(name, fieldPointer));
 		return *this;
 	}
 
 	template<typename ObjectType, typename ReturnType, typename SetType>
 	ObjectDesc& AddProperty(const std::string& name, ReturnType(ObjectType::* getter)(), void (ObjectType::* setter)(SetType) = nullptr)
 	{
-		auto findResult = m_properties.find(name);
-		assert(findResult == m_properties.end());
-
-		Property* prop = new AccessorProperty<ObjectType, ReturnType, SetType>(name, getter, setter);
-		m_properties[name] = prop;
+		InsertProperty(CreateProperty<AccessorProperty<ObjectType, ReturnType, SetType>>(name, getter, setter));
 		return *this;
 	}
 
 	template<typename ObjectType, typename ReturnType, typename SetType>
 	ObjectDesc& AddProperty(const std::string& name, ReturnType(ObjectType::* getter)() const, void (ObjectType::* setter)(SetType) = nullptr)
 	{
-		auto findResult = m_properties.find(name);
-		assert(findResult == m_properties.end());
-
-		Property* prop = new AccessorProperty<ObjectType, ReturnType, SetType>(name, getter, setter);
-		m_properties[name] = prop;
+		InsertProperty(CreateProperty<AccessorProperty<ObjectType, ReturnType, SetType>>(name, getter, setter));
 		return *this;
 	}
 
-	const std::unordered_map<std::string, Property*>& GetProperties() const { return m_properties; }
+	// In declaration order, properties of the base objects first. The flattened list is
+	// built on first use after properties change, plans build it for every descriptor.
+	// Inherited properties expect the base subobject, see GetPropertyAdjustments.
+	const std::vector<Property*>& GetProperties() const
+	{
+		UpdateProperties();
+		return m_properties;
+	}
+	// Parallel to GetProperties, nullptr for properties declared by the object itself
+	const std::vector<const BaseAdjustment*>& GetPropertyAdjustments() const
+	{
+		UpdateProperties();
+		return m_propertyAdjustments;
+	}
+	// Properties added to this descriptor only
+	const std::vector<Property*>& GetOwnProperties() const { return m_ownProperties; }
+	// Nullptr when neither the object nor its bases have a property with the name.
+	// An inherited property expects a pointer to the base subobject which declares it.
+	Property* FindProperty(const std::string& name) const
+	{
+		auto findResult = m_ownPropertiesByName.find(name);
+		if (findResult != m_ownPropertiesByName.end())
+		{
+			return findResult->second;
+		}
+		for (const auto& base : m_bases)
+		{
+			if (Property* prop = base.desc->FindProperty(name))
+			{
+				return prop;
+			}
+		}
+		return nullptr;
+	}
+
+	// Direct base of a registered object
+	struct Base
+	{
+		const ObjectDesc* desc = nullptr;
+		// Offset of the base subobject, constant for non-virtual bases
+		ptrdiff_t offset = 0;
+		// Set for virtual bases instead of the offset
+		BaseCast cast = nullptr;
+	};
+	// In registration order, empty for objects registered without bases
+	const std::vector<Base>& GetBases() const { return m_bases; }
 	const std::string& GetName() const { return m_name; }
+	uintptr_t GetId() const { return m_id; }
+	ConcreteObjectFactory* GetFactory() const { return m_factory; }
 
 private:
+	// Properties are placed in the property arena of ObjectFactory and live as long as it
+	template<typename PropertyType, typename... Args>
+	Property* CreateProperty(Args&&... args)
+	{
+		assert(m_propertyAllocator != nullptr && "Object is not registered");
+		void* memory = m_propertyAllocator->Allocate(sizeof(PropertyType), alignof(PropertyType));
+		PropertyType* prop = new (memory) PropertyType(std::forward<Args>(args)...);
+		m_propertyAllocator->AddDestructor(prop, DestructValue<PropertyType>);
+		return prop;
+	}
+
+	void InsertProperty(Property* prop)
+	{
+		assert(FindProperty(prop->GetName()) == nullptr && "Property is already added");
+
+		m_ownPropertiesByName.emplace(prop->GetName(), prop);
+		m_ownProperties.push_back(prop);
+		OnPropertiesChanged();
+	}
+
+	void UpdateProperties() const
+	{
+		const size_t version = GetPropertiesVersion();
+		if (m_propertiesVersion != version)
+		{
+			FlattenProperties();
+			m_propertiesVersion = version;
+		}
+	}
+
+	void FlattenProperties() const;
+	// Invalidates flattened properties of all descriptors and serialization plans
+	void OnPropertiesChanged();
+	static size_t GetPropertiesVersion();
+
+	static constexpr size_t InvalidVersion = static_cast<size_t>(-1);
+
 	ConcreteObjectFactory* m_factory = nullptr;
-	std::unordered_map<std::string, Property*> m_properties;
+	ObjectAllocator* m_propertyAllocator = nullptr;
+	std::vector<Base> m_bases;
+	std::vector<Property*> m_ownProperties;
+	std::unordered_map<std::string, Property*> m_ownPropertiesByName;
+	// Base properties followed by own ones
+	mutable std::vector<Property*> m_properties;
+	mutable std::vector<const BaseAdjustment*> m_propertyAdjustments;
+	// Stable storage for m_propertyAdjustments
+	mutable std::deque<BaseAdjustment> m_adjustments;
+	// Stable storage for copies of repeated base properties in m_properties
+	mutable std::deque<RenamedProperty> m_renamedProperties;
+	mutable size_t m_propertiesVersion = InvalidVersion;
 	std::string m_name;
+	uintptr_t m_id = 0U;
 
 	friend class ObjectFactory;
 };
@@ -1,3 +1,144 @@
 #include "ObjectFactory.h"
 
+#include <unordered_set>
 
+constexpr size_t ObjectDesc::InvalidVersion;
+
+// Properties reached through a virtual base belong to the single shared subobject
+static bool HasVirtualStep(const BaseAdjustment* adjustment)
+{
+	for (; adjustment != nullptr; adjustment = adjustment->next)
+	{
+		if (adjustment->cast != nullptr)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void ObjectDesc::FlattenProperties() const
+{
+	m_properties.clear();
+	m_propertyAdjustments.clear();
+	m_adjustments.clear();
+	m_renamedProperties.clear();
+
+	// Own properties shadow base properties with the same name, which a base may get
+	// after this object was registered. Plans need every name to be unique.
+	std::unordered_set<std::string> names;
+	for (const auto& prop : m_ownProperties)
+	{
+		names.insert(prop->GetName());
+	}
+
+	// Properties of a virtual base reached through several bases are taken once.
+	// A non-virtual base reached twice is two subobjects, the later copy of every
+	// property is named after the direct base it comes through, e.g. "Right::value".
+	std::unordered_set<const Property*> addedProperties;
+	std::unordered_set<const Property*> virtualProperties;
+	for (const auto& base : m_bases)
+	{
+		const auto& baseProperties = base.desc->GetProperties();
+		const auto& baseAdjustments = base.desc->GetPropertyAdjustments();
+
+		// Properties of one base subobject share the adjustment
+		std::unordered_map<const BaseAdjustment*, const BaseAdjustment*> adjustments;
+		for (size_t i = 0U; i < baseProperties.size(); ++i)
+		{
+			Property* prop = baseProperties[i];
+			const bool isVirtual = base.cast != nullptr || HasVirtualStep(baseAdjustments[i]);
+			if (isVirtual && !virtualProperties.insert(prop).second)
+			{
+				continue;
+			}
+
+			const std::string& name = prop->GetName();
+			if (m_ownPropertiesByName.count(name) != 0U)
+			{
+				continue;
+			}
+			if (!names.insert(name).second)
+			{
+				if (addedProperties.count(prop) == 0U)
+				{
+					// Only the first base keeps the property in release builds
+					assert(false && "Several bases have a property with the same name");
+					continue;
+				}
+
+				m_renamedProperties.emplace_back(base.desc->GetName() + "::" + name, prop);
+				prop = &m_renamedProperties.back();
+				if (!names.insert(prop->GetName()).second)
+				{
+					assert(false && "Repeated base property can not be named uniquely");
+					continue;
+				}
+			}
+			addedProperties.insert(baseProperties[i]);
+
+			auto findResult = adjustments.find(baseAdjustments[i]);
+			if (findResult == adjustments.end())
+			{
+				BaseAdjustment adjustment;
+				adjustment.offset = base.offset;
+				adjustment.cast = base.cast;
+				adjustment.next = baseAdjustments[i];
+				m_adjustments.push_back(adjustment);
+				findResult = adjustments.emplace(baseAdjustments[i], &m_adjustments.back()).first;
+			}
+
+			m_properties.push_back(prop);
+			m_propertyAdjustments.push_back(findResult->second);
+		}
+	}
+
+	m_properties.insert(m_properties.end(), m_ownProperties.begin(), m_ownProperties.end());
+	m_propertyAdjustments.resize(m_properties.size(), nullptr);
+}
+
+void ObjectDesc::OnPropertiesChanged()
+{
+	auto& factory = ObjectFactory::GetInstance();
+	++factory.m_propertiesVersion;
+	factory.GetSerializationPlans().Clear();
+}
+
+size_t ObjectDesc::GetPropertiesVersion()
+{
+	return ObjectFactory::GetInstance().m_propertiesVersion;
+}
+
+const ObjectDesc* ObjectFactory::FindObjectDesc(const char* objectName, const size_t length) const
+{
+	const auto range = m_descsByNameHash.equal_range(HashObjectName(objectName, length));
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		const auto& name = it->second->GetName();
+		if (name.size() == length && std::memcmp(name.data(), objectName, length) == 0)
+		{
+			return it->second;
+		}
+	}
+	return nullptr;
+}
+
+size_t ObjectFactory::HashObjectName(const char* objectName, const size_t length)
+{
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ULL;
+	for (size_t i = 0U; i < length; ++i)
+	{
+		hash ^= static_cast<uint8_t>(objectName[i]);
+		hash *= 1099511628211ULL;
+	}
+	return static_cast<size_t>(hash);
+}
+
+void ObjectFactory::AddToNameIndex(const ObjectDesc& objectDesc)
+{
+	const auto& name = objectDesc.GetName();
+	assert(FindObjectDesc(name.data(), name.size()) == nullptr);
+
+	m_descsByNameHash.emplace(HashObjectName(name.data(), name.size()), &objectDesc);
+}
@@ -4,14 +4,29 @@
 #include "ObjectDesc.h"
 #include "Property.h"
 #include "TempContainer.h"
+#include "SerializationPlan.h"
 
 #include <string>
 #include <unordered_map>
 #include <cassert>
 #include <memory>
 #include <algorithm>
+#include <cstring>
+#include <type_traits>
 
 
+// Address of the tag identifies ObjectType for the process lifetime. The address is a
+// constant expression, and no ObjectType instance is ever created for it. The tag is not
+// const, so identical-data folding (MSVC /OPT:ICF) cannot merge the tags of different types.
+template<typename ObjectType>
+struct ObjectIdTag
+{
+	static char tag;
+};
+
+template<typename ObjectType>
+char ObjectIdTag<ObjectType>::tag = 0;
+
 class ObjectFactory
 {
 public:
@@ -25,34 +40,31 @@ public:
     ObjectDesc& RegisterObject(const std::string& objectName)
     {
 		const auto objectId = GetObjectId<ObjectType>();
-		auto findResult = m_descs.find(objectId);
-		assert(findResult == m_descs.end());
+		assert(m_descs.find(objectId) == m_descs.end() && "Object is already registered");
 
 		m_descs[objectId] = ObjectDesc(objectName);
-		auto& objectDesc = m_descs.at(objectId);
+		ObjectDesc& objectDesc = m_descs.at(objectId);
+		objectDesc.m_id = objectId;
+		objectDesc.m_propertyAllocator = &m_propertyArena;
 		objectDesc.CreateFactory<ObjectType>();
+		m_serializationPlans.Clear();
+		AddToNameIndex(objectDesc);
         return objectDesc;
     }
 
-	template<typename ObjectType, typename BaseObjectType>
+	// Properties of the bases are shared, not copied. Descriptors are never removed and
+	// map nodes are stable, so base pointers stay valid. Bases must be registered first.
+	template<typename ObjectType, typename BaseObjectType, typename... OtherBaseObjectTypes>
 	ObjectDesc& RegisterObject(const std::string& objectName)
 	{
-		const auto objectId = GetObjectId<ObjectType>();
-		auto findResult = m_descs.find(objectId);
-		assert(findResult == m_descs.end());
+		ObjectDesc& objectDesc = RegisterObject<ObjectType>(objectName);
 
-		m_descs[objectId] = ObjectDesc(objectName);
-		auto& objectDesc = m_descs.at(objectId);
-		objectDesc.CreateFactory<ObjectType>();
+		using Expander = int[];
+		(void)Expander{ AddBase<ObjectType, BaseObjectType>(objectDesc), AddBase<ObjectType, OtherBaseObjectTypes>(objectDesc)... };
+		++m_propertiesVersion;
 
-		// Fill with BaseObjectType properties
-		const auto baseObjectId = GetObjectId<BaseObjectType>();
-		findResult = m_descs.find(baseObjectId);
-		if (findResult != m_descs.end())
-		{
-			auto& baseObjectDesc = m_descs.at(baseObjectId);
-			objectDesc.m_properties = baseObjectDesc.m_properties;
-		}
+		// Flattened right away, so names clashing between the bases fail here
+		objectDesc.GetProperties();
 		return objectDesc;
 	}
 
@@ -76,21 +88,28 @@ public:
 
 	const ObjectDesc& GetObjectDesc(const std::string& objectName)
 	{
-		using map_value = std::unordered_map<uintptr_t, ObjectDesc>::value_type;
-		auto findResult = std::find_if(m_descs.begin(), m_descs.end(), [&objectName](const map_value& value)
-		{
-			return value.second.GetName() == objectName;
-		});
-		assert(findResult != m_descs.end());
+		auto objectDesc = FindObjectDesc(objectName.data(), objectName.size());
+		assert(objectDesc != nullptr);
 
-		return findResult->second;
+		return *objectDesc;
+	}
+
+	const ObjectDesc& GetObjectDesc(const char* objectName)
+	{
+		auto objectDesc = FindObjectDesc(objectName, std::strlen(objectName));
+		assert(objectDesc != nullptr);
+
+		return *objectDesc;
 	}
 
+	// Name lookup without building a std::string, returns nullptr for unknown names
+	const ObjectDesc* FindObjectDesc(const char* objectName, const size_t length) const;
+
 	template<typename ObjectType>
 	static uintptr_t GetObjectId()
 	{
-		static ObjectType s_inst;
-		return reinterpret_cast<uintptr_t>(&s_inst);
+		using BaseType = typename std::remove_cv<ObjectType>::type;
+		return reinterpret_cast<uintptr_t>(&ObjectIdTag<BaseType>::tag);
 	}
 
 	template<typename ObjectType>
@@ -101,13 +120,73 @@ public:
 		return findResult != m_descs.end();
 	}
 
-	TempContainer& GetTempContainer(const size_t index = 0U) { return m_tempContainers[index]; }
+	const std::unordered_map<uintptr_t, ObjectDesc>& GetObjectDescs() const { return m_descs; }
+
+	SerializationPlans& GetSerializationPlans() { return m_serializationPlans; }
 
 private:
+	friend class ObjectDesc;
+
+	// Records where the BaseObjectType subobject is, so plans apply inherited properties to it
+	template<typename ObjectType, typename BaseObjectType>
+	int AddBase(ObjectDesc& objectDesc)
+	{
+		static_assert(std::is_base_of<BaseObjectType, ObjectType>::value, "Object is not derived from the base");
+
+		auto findResult = m_descs.find(GetObjectId<BaseObjectType>());
+		if (findResult == m_descs.end())
+		{
+			return 0;
+		}
+
+		ObjectDesc::Base base;
+		base.desc = &findResult->second;
+		SetBaseAdjustment<ObjectType, BaseObjectType>(base, is_virtual_base_of<BaseObjectType, ObjectType>());
+		objectDesc.m_bases.push_back(base);
+		return 0;
+	}
+
+	template<typename ObjectType, typename BaseObjectType>
+	static void SetBaseAdjustment(ObjectDesc::Base& base, std::false_type)
+	{
+		// Casting to a non-virtual base only adds a constant, no object is accessed
+		typename std::aligned_storage<sizeof(ObjectType), alignof(ObjectType)>::type storage;
+		ObjectType* object = reinterpret_cast<ObjectType*>(&storage);
+		BaseObjectType* baseObject = object;
+		base.offset = reinterpret_cast<char*>(baseObject) - reinterpret_cast<char*>(object);
+	}
+
+	template<typename ObjectType, typename BaseObjectType>
+	static void SetBaseAdjustment(ObjectDesc::Base& base, std::true_type)
+	{
+		base.cast = CastToBase<ObjectType, BaseObjectType>;
+	}
+
+	static size_t HashObjectName(const char* objectName, const size_t length);
+	void AddToNameIndex(const ObjectDesc& objectDesc);
+
+	// Owns the properties of all descriptors, declared first to outlive them
+	ObjectArena m_propertyArena;
+	// Incremented when properties of any descriptor change
+	size_t m_propertiesVersion = 0U;
     std::unordered_map<uintptr_t, ObjectDesc> m_descs;
-	std::array<TempContainer, 2U> m_tempContainers;
+	// Keyed by HashObjectName, so lookups can hash any character range
+	std::unordered_multimap<size_t, const ObjectDesc*> m_descsByNameHash;
+	SerializationPlans m_serializationPlans;
 };
 
+template<typename ObjectType>
+bool IsObjectTypeRegistered()
+{
+	return ObjectFactory::GetInstance().IsObjectRegistered<ObjectType>();
+}
+
+template<typename ObjectType>
+uintptr_t GetObjectTypeId()
+{
+	return ObjectFactory::GetObjectId<ObjectType>();
+}
+
 template<typename ObjectType>
 ObjectDesc& class_(const std::string& objectName)
 {
@@ -115,11 +194,11 @@ ObjectDesc& class_(const std::string& objectName)
     return instance.RegisterObject<ObjectType>(objectName);
 }
 
-template<typename ObjectType, typename BaseObjectType>
+template<typename ObjectType, typename BaseObjectType, typename... OtherBaseObjectTypes>
 ObjectDesc& class_(const std::string& objectName)
 {
 	auto& instance = ObjectFactory::GetInstance();
-	return instance.RegisterObject<ObjectType, BaseObjectType>(objectName);
+	return instance.RegisterObject<ObjectType, BaseObjectType, OtherBaseObjectTypes...>(objectName);
 }
 
 #endif
@@ -0,0 +1,46 @@
+#ifndef PARALLEL_INCLUDE
+#define PARALLEL_INCLUDE
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+inline size_t GetDefaultWorkersCount()
+{
+	const size_t hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 0U ? hardwareThreads : 1U;
+}
+
+// Runs func(taskIndex, workerIndex) for every task on up to workersCount threads,
+// the calling thread included. Workers take the next free task from a shared
+// counter, so threads which finish early pick up the remaining work.
+template<typename Func>
+void ParallelFor(const size_t tasksCount, size_t workersCount, Func func)
+{
+	workersCount = std::max<size_t>(1U, std::min(workersCount, tasksCount));
+
+	std::atomic<size_t> nextTask{ 0U };
+	auto worker = [&](const size_t workerIndex)
+	{
+		for (size_t task = nextTask.fetch_add(1U); task < tasksCount; task = nextTask.fetch_add(1U))
+		{
+			func(task, workerIndex);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(workersCount - 1U);
+	for (size_t i = 1U; i < workersCount; ++i)
+	{
+		threads.emplace_back(worker, i);
+	}
+	worker(0U);
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+#endif
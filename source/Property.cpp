@@ -1,7 +1,8 @@
 #include "Property.h"
 
+constexpr size_t Property::InvalidOffset;
+
 const std::string& Property::GetName() const
 {
     return m_name;
 }
-
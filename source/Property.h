@@ -2,6 +2,7 @@
 #define PROPERTY_INCLUDE
 
 #include "TypeInfo.h"
+#include "TempContainer.h"
 
 #include <string>
 #include <type_traits>
@@ -13,9 +14,12 @@ public:
     const std::string& GetName() const;
 
 	virtual void SetValue(void* object, void* data) = 0;
-	virtual void* GetValue(void* object) = 0;
+	// Like SetValue, but data may be left moved-from. Serializers pass their decoded temporaries.
+	virtual void MoveValue(void* object, void* data) = 0;
+	// Accessor properties store the getter result in a container pushed on tempStack
+	virtual void* GetValue(void* object, TempStack& tempStack) = 0;
 
-	const TypeInfo::Type GetType() const
+	TypeInfo::Type GetType() const
 	{
 		return m_typeInfo->type;
 	}
@@ -25,8 +29,14 @@ public:
 		return *m_typeInfo;
 	}
 
+	// Byte offset of the field inside the object, InvalidOffset for accessor properties
+	size_t GetOffset() const { return m_offset; }
+
+	static constexpr size_t InvalidOffset = static_cast<size_t>(-1);
+
 protected:
 	const TypeInfo* m_typeInfo = nullptr;
+	size_t m_offset = InvalidOffset;
 
 private:
     std::string m_name = "";
@@ -47,6 +57,12 @@ public:
 			typeInfoCollection.RegisterTypeInfo<FieldType>();
 		}
 		m_typeInfo = typeInfoCollection.GetTypeInfo<FieldType>();
+
+		// Resolve the member pointer against unconstructed storage, no object is touched
+		typename std::aligned_storage<sizeof(ObjectType), alignof(ObjectType)>::type storage;
+		char* objectAddress = reinterpret_cast<char*>(&storage);
+		char* fieldAddress = reinterpret_cast<char*>(&(reinterpret_cast<ObjectType*>(objectAddress)->*fieldPtr));
+		m_offset = static_cast<size_t>(fieldAddress - objectAddress);
     }
 
     void SetValue(void* object, void* data) override final
@@ -54,7 +70,12 @@ public:
 		m_assigner(object, data);
     }
 
-    void* GetValue(void* object) override final
+	void MoveValue(void* object, void* data) override final
+	{
+		m_assigner.Move(object, data);
+	}
+
+    void* GetValue(void* object, TempStack&) override final
     {
         ObjectType* concreteObject = reinterpret_cast<ObjectType*>(object);
 		return reinterpret_cast<void*>(&(concreteObject->*(m_assigner.fieldPtr)));
@@ -74,8 +95,8 @@ public:
 		, m_getter(getter)
 		, m_setter(setter)
     {
-		using NonReferenceType = std::remove_reference<SetType>::type;
-		using BaseType = std::remove_cv<NonReferenceType>::type;
+		using NonReferenceType = typename std::remove_reference<SetType>::type;
+		using BaseType = typename std::remove_cv<NonReferenceType>::type;
 
 		auto& typeInfoCollection = TypeInfoCollection::GetInstance();
 		if (!typeInfoCollection.IsTypeInfoRegistered<BaseType>())
@@ -90,8 +111,8 @@ public:
 		, m_constGetter(getter)
 		, m_setter(setter)
     {
-		using NonReferenceType = std::remove_reference<SetType>::type;
-		using BaseType = std::remove_cv<NonReferenceType>::type;
+		using NonReferenceType = typename std::remove_reference<SetType>::type;
+		using BaseType = typename std::remove_cv<NonReferenceType>::type;
 
 		auto& typeInfoCollection = TypeInfoCollection::GetInstance();
 		if (!typeInfoCollection.IsTypeInfoRegistered<BaseType>())
@@ -103,36 +124,95 @@ public:
 
     void SetValue(void* object, void* data) override final
     {
-		using NonReferenceType = std::remove_reference<SetType>::type;
-		using BaseType = std::remove_cv<NonReferenceType>::type;
+		using NonReferenceType = typename std::remove_reference<SetType>::type;
+		using BaseType = typename std::remove_cv<NonReferenceType>::type;
 		BaseType* actualDataPtr = reinterpret_cast<BaseType*>(data);
 
 		ObjectType* concreteObject = reinterpret_cast<ObjectType*>(object);
-		(concreteObject->*m_setter)(*actualDataPtr);
+		if (m_setter)
+		{
+			(concreteObject->*m_setter)(CopyForSetter(*actualDataPtr));
+		}
     }
 
-    void* GetValue(void* object) override final
+	void MoveValue(void* object, void* data) override final
+	{
+		using NonReferenceType = typename std::remove_reference<SetType>::type;
+		using BaseType = typename std::remove_cv<NonReferenceType>::type;
+		BaseType* actualDataPtr = reinterpret_cast<BaseType*>(data);
+
+		// By value and T&& setters take the value over, T& and const T& setters see it in place
+		ObjectType* concreteObject = reinterpret_cast<ObjectType*>(object);
+		if (m_setter)
+		{
+			(concreteObject->*m_setter)(std::forward<SetType>(*actualDataPtr));
+		}
+	}
+
+    void* GetValue(void* object, TempStack& tempStack) override final
     {
-		auto& tempContainer = ObjectFactory::GetInstance().GetTempContainer();
+		auto& tempContainer = tempStack.Push();
 		ObjectType* concreteObject = reinterpret_cast<ObjectType*>(object);
-		void* data = nullptr;
 		if (m_getter)
 		{
-			auto value = (concreteObject->*m_getter)();
-			tempContainer.SetValue(value);
+			tempContainer.SetValue((concreteObject->*m_getter)());
 		}
 		else if (m_constGetter)
 		{
-			auto value = (concreteObject->*m_constGetter)();
-			tempContainer.SetValue(value);
+			tempContainer.SetValue((concreteObject->*m_constGetter)());
 		}
 		return tempContainer.GetData();
     }
 
 private:
+	// A T&& setter gets a copy, so SetValue leaves the data intact
+	template<typename ValueType, typename S = SetType>
+	static std::enable_if_t<std::is_rvalue_reference<S>::value, ValueType> CopyForSetter(ValueType& value)
+	{
+		return value;
+	}
+
+	template<typename ValueType, typename S = SetType>
+	static std::enable_if_t<!std::is_rvalue_reference<S>::value, ValueType&> CopyForSetter(ValueType& value)
+	{
+		return value;
+	}
+
 	ReturnType(ObjectType::* m_getter)()  = nullptr;
 	ReturnType(ObjectType::* m_constGetter)() const  = nullptr;
 	void (ObjectType::* m_setter)(SetType) = nullptr;
 };
 
+
+// Another property under a different name, for repeated non-virtual base subobjects
+class RenamedProperty : public Property
+{
+public:
+	RenamedProperty(const std::string& name, Property* property)
+		: Property(name)
+		, m_property(property)
+	{
+		m_typeInfo = &property->GetTypeInfo();
+		m_offset = property->GetOffset();
+	}
+
+	void SetValue(void* object, void* data) override final
+	{
+		m_property->SetValue(object, data);
+	}
+
+	void MoveValue(void* object, void* data) override final
+	{
+		m_property->MoveValue(object, data);
+	}
+
+	void* GetValue(void* object, TempStack& tempStack) override final
+	{
+		return m_property->GetValue(object, tempStack);
+	}
+
+private:
+	Property* m_property = nullptr;
+};
+
 #endif
@@ -0,0 +1,277 @@
+#include "SerializationPlan.h"
+#include "ObjectFactory.h"
+
+#include <cstring>
+
+constexpr size_t SerializationPlans::InvalidIndex;
+
+size_t SerializationPlans::GetPlanIndex(const uintptr_t objectDescId)
+{
+	if (!m_isCompiled.load(std::memory_order_acquire))
+	{
+		std::lock_guard<std::mutex> lock(m_compileMutex);
+		if (!m_isCompiled.load(std::memory_order_relaxed))
+		{
+			CompileAll();
+		}
+	}
+
+	auto findResult = m_planIndices.find(objectDescId);
+	assert(findResult != m_planIndices.end());
+
+	return findResult->second;
+}
+
+void SerializationPlans::Clear()
+{
+	m_steps.clear();
+	m_plans.clear();
+	m_nameSlots.clear();
+	m_planIndices.clear();
+	m_isCompiled.store(false, std::memory_order_release);
+}
+
+void SerializationPlans::CompileAll()
+{
+	Clear();
+
+	const auto& descs = ObjectFactory::GetInstance().GetObjectDescs();
+	for (const auto& desc : descs)
+	{
+		Compile(desc.first);
+	}
+	ComputeHasPointers();
+	m_isCompiled.store(true, std::memory_order_release);
+}
+
+void SerializationPlans::ComputeHasPointers()
+{
+	// Objects may refer to each other, so flags spread until nothing changes
+	bool isChanged = true;
+	while (isChanged)
+	{
+		isChanged = false;
+		for (auto& plan : m_plans)
+		{
+			for (size_t i = 0U; i < plan.stepsCount && !plan.hasPointers; ++i)
+			{
+				if (HasPointers(*m_steps[plan.firstStep + i].typeInfo))
+				{
+					plan.hasPointers = true;
+					isChanged = true;
+				}
+			}
+		}
+	}
+}
+
+bool SerializationPlans::HasPointers(const TypeInfo& typeInfo) const
+{
+	switch (typeInfo.type)
+	{
+	case TypeInfo::Pointer:
+		return true;
+	case TypeInfo::Array:
+		return HasPointers(*typeInfo.arrayParams.elementTypeInfo);
+	case TypeInfo::Map:
+		return HasPointers(*typeInfo.mapParams.keyTypeInfo) || HasPointers(*typeInfo.mapParams.valueTypeInfo);
+	case TypeInfo::Class:
+	{
+		auto findResult = m_planIndices.find(typeInfo.GetObjectDescId());
+		return findResult != m_planIndices.end() && m_plans[findResult->second].hasPointers;
+	}
+	default:
+		return false;
+	}
+}
+
+size_t SerializationPlans::Compile(const uintptr_t objectDescId)
+{
+	auto findResult = m_planIndices.find(objectDescId);
+	if (findResult != m_planIndices.end())
+	{
+		return findResult->second;
+	}
+
+	const auto& objectDesc = ObjectFactory::GetInstance().GetObjectDesc(objectDescId);
+	const auto& properties = objectDesc.GetProperties();
+	const auto& adjustments = objectDesc.GetPropertyAdjustments();
+
+	// Indexed before the nested plans, so self-referential objects find it
+	const size_t planIndex = m_plans.size();
+	m_plans.emplace_back();
+	m_planIndices[objectDescId] = planIndex;
+
+	// Nested plans are compiled first, so collect own steps aside to keep them contiguous
+	std::vector<SerializationStep> steps;
+	steps.reserve(properties.size());
+	for (size_t i = 0U; i < properties.size(); ++i)
+	{
+		Property* prop = properties[i];
+		const auto& typeInfo = prop->GetTypeInfo();
+
+		SerializationStep step;
+		step.offset = prop->GetOffset();
+		step.property = prop;
+
+		// Adjustments to non-virtual bases are folded once here, fields of virtual
+		// bases are reached through the property like accessors
+		const BaseAdjustment* adjustment = adjustments[i];
+		if (adjustment && adjustment->IsConstant())
+		{
+			step.baseOffset = adjustment->GetConstantOffset();
+			if (step.offset != Property::InvalidOffset)
+			{
+				step.offset += step.baseOffset;
+			}
+		}
+		else if (adjustment)
+		{
+			step.baseAdjustment = adjustment;
+			step.offset = Property::InvalidOffset;
+		}
+		step.typeInfo = &typeInfo;
+		step.type = typeInfo.type;
+		step.elementsCount = typeInfo.arrayParams.elementsCount;
+
+		const TypeInfo* innerTypeInfo = &typeInfo;
+		while (innerTypeInfo->type == TypeInfo::Array)
+		{
+			innerTypeInfo = innerTypeInfo->arrayParams.elementTypeInfo;
+		}
+		if (innerTypeInfo->type == TypeInfo::Class)
+		{
+			step.nestedPlanIndex = Compile(innerTypeInfo->GetObjectDescId());
+		}
+
+		steps.push_back(step);
+	}
+
+	SerializationPlan plan;
+	plan.objectDesc = &objectDesc;
+	plan.firstStep = m_steps.size();
+	plan.stepsCount = steps.size();
+	m_steps.insert(m_steps.end(), steps.begin(), steps.end());
+	BuildNameSlots(plan);
+	m_plans[planIndex] = plan;
+
+	return planIndex;
+}
+
+size_t SerializationPlans::FindStep(const SerializationPlan& plan, const char* name, const size_t length) const
+{
+	if (plan.stepsCount == 0U)
+	{
+		return InvalidIndex;
+	}
+
+	uint32_t slot = HashStepName(name, length, plan.nameHashSeed) & plan.nameSlotsMask;
+	for (;;)
+	{
+		const size_t stepIndex = m_nameSlots[plan.firstNameSlot + slot];
+		if (stepIndex == InvalidIndex)
+		{
+			return InvalidIndex;
+		}
+
+		// Unknown names may land in an occupied slot too
+		const auto& stepName = m_steps[plan.firstStep + stepIndex].property->GetName();
+		if (stepName.size() == length && std::memcmp(stepName.data(), name, length) == 0)
+		{
+			return stepIndex;
+		}
+		if (!plan.isNameProbing)
+		{
+			return InvalidIndex;
+		}
+
+		// Probing tables are at most half full, an empty slot always ends the search
+		slot = (slot + 1U) & plan.nameSlotsMask;
+	}
+}
+
+uint32_t SerializationPlans::HashStepName(const char* name, const size_t length, const uint32_t seed)
+{
+	// FNV-1a with a seeded offset basis
+	uint32_t hash = 2166136261U ^ seed;
+	for (size_t i = 0U; i < length; ++i)
+	{
+		hash ^= static_cast<uint8_t>(name[i]);
+		hash *= 16777619U;
+	}
+	return hash ^ (hash >> 16);
+}
+
+void SerializationPlans::BuildNameSlots(SerializationPlan& plan)
+{
+	plan.firstNameSlot = m_nameSlots.size();
+	if (plan.stepsCount == 0U)
+	{
+		return;
+	}
+
+	// Look for a seed without collisions, growing the table when none fits
+	const uint32_t seedsPerSize = 256U;
+	uint32_t slotsCount = 1U;
+	while (slotsCount < plan.stepsCount)
+	{
+		slotsCount <<= 1;
+	}
+
+	// Collision-free tables grow roughly with the square of the names count, so large
+	// plans stop at a small multiple of it and fall back to linear probing
+	const uint32_t maxSlotsCount = slotsCount << 3;
+
+	std::vector<size_t> slots;
+	for (;;)
+	{
+		for (uint32_t seed = 0U; seed < seedsPerSize; ++seed)
+		{
+			slots.assign(slotsCount, InvalidIndex);
+
+			bool hasCollision = false;
+			for (size_t i = 0U; i < plan.stepsCount && !hasCollision; ++i)
+			{
+				const auto& name = m_steps[plan.firstStep + i].property->GetName();
+				const uint32_t slot = HashStepName(name.data(), name.size(), seed) & (slotsCount - 1U);
+				hasCollision = slots[slot] != InvalidIndex;
+				slots[slot] = i;
+			}
+
+			if (!hasCollision)
+			{
+				plan.nameSlotsMask = slotsCount - 1U;
+				plan.nameHashSeed = seed;
+				m_nameSlots.insert(m_nameSlots.end(), slots.begin(), slots.end());
+				return;
+			}
+		}
+		if (slotsCount >= maxSlotsCount)
+		{
+			break;
+		}
+		slotsCount <<= 1;
+	}
+
+	// At least twice as many slots as names, so probes stay short
+	slotsCount = 2U;
+	while (slotsCount < plan.stepsCount * 2U)
+	{
+		slotsCount <<= 1;
+	}
+	plan.nameSlotsMask = slotsCount - 1U;
+	plan.nameHashSeed = 0U;
+	plan.isNameProbing = true;
+	slots.assign(slotsCount, InvalidIndex);
+	for (size_t i = 0U; i < plan.stepsCount; ++i)
+	{
+		const auto& name = m_steps[plan.firstStep + i].property->GetName();
+		uint32_t slot = HashStepName(name.data(), name.size(), 0U) & plan.nameSlotsMask;
+		while (slots[slot] != InvalidIndex)
+		{
+			slot = (slot + 1U) & plan.nameSlotsMask;
+		}
+		slots[slot] = i;
+	}
+	m_nameSlots.insert(m_nameSlots.end(), slots.begin(), slots.end());
+}
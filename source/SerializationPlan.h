@@ -0,0 +1,113 @@
+#ifndef SERIALIZATION_PLAN_INCLUDE
+#define SERIALIZATION_PLAN_INCLUDE
+
+#include "Property.h"
+#include "ObjectDesc.h"
+
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <mutex>
+
+// One property of a compiled ObjectDesc
+struct SerializationStep
+{
+	void* GetData(void* object, TempStack& tempStack) const
+	{
+		if (offset != Property::InvalidOffset)
+		{
+			return reinterpret_cast<char*>(object) + offset;
+		}
+		return property->GetValue(GetPropertyObject(object), tempStack);
+	}
+
+	// Stores data into the property after GetData returned a temporary
+	void MoveValue(void* object, void* data) const
+	{
+		property->MoveValue(GetPropertyObject(object), data);
+	}
+
+	bool IsDirectField() const { return offset != Property::InvalidOffset; }
+
+	// Subobject which declares the property
+	void* GetPropertyObject(void* object) const
+	{
+		if (baseAdjustment)
+		{
+			return baseAdjustment->Apply(object);
+		}
+		return reinterpret_cast<char*>(object) + baseOffset;
+	}
+
+	// From the start of the object, base offsets included
+	size_t offset = Property::InvalidOffset;
+	Property* property = nullptr;
+	// Constant offset of the base subobject which declares the property
+	ptrdiff_t baseOffset = 0;
+	// Set instead when a virtual base is on the way to that subobject
+	const BaseAdjustment* baseAdjustment = nullptr;
+	const TypeInfo* typeInfo = nullptr;
+	TypeInfo::Type type = TypeInfo::Undefined;
+	// For C-style and static arrays
+	size_t elementsCount = 0U;
+	// Plan of the field class, or of the innermost array element class
+	size_t nestedPlanIndex = static_cast<size_t>(-1);
+};
+
+struct SerializationPlan
+{
+	const ObjectDesc* objectDesc = nullptr;
+	size_t firstStep = 0U;
+	size_t stepsCount = 0U;
+	// Perfect hash of the property names, see SerializationPlans::FindStep
+	size_t firstNameSlot = 0U;
+	uint32_t nameSlotsMask = 0U;
+	uint32_t nameHashSeed = 0U;
+	// Set when no perfect hash fits a small table, names are then found by linear probing
+	bool isNameProbing = false;
+	// Some property holds a pointer, directly or inside nested values
+	bool hasPointers = false;
+};
+
+// Flattened form of every registered ObjectDesc. All descs are compiled at once on
+// first use, so executing a plan never compiles (and never moves the steps storage).
+// Compilation is guarded, plans can be used by serializers on several threads.
+class SerializationPlans
+{
+public:
+	static constexpr size_t InvalidIndex = static_cast<size_t>(-1);
+
+	size_t GetPlanIndex(const uintptr_t objectDescId);
+
+	const SerializationPlan& GetPlan(const size_t index) const { return m_plans[index]; }
+	const SerializationStep* GetSteps(const SerializationPlan& plan) const { return m_steps.data() + plan.firstStep; }
+
+	// Index of the plan step with the given property name or InvalidIndex.
+	// Costs one hash and one name comparison, the name may come straight from the input.
+	// Plans with very many properties may probe a few more slots.
+	size_t FindStep(const SerializationPlan& plan, const char* name, const size_t length) const;
+
+	// Values of the type hold pointers, directly or inside nested values. Deserializers
+	// keep addresses of such values until DeserializePointers, so they must not move.
+	bool HasPointers(const TypeInfo& typeInfo) const;
+
+	void Clear();
+
+private:
+	void CompileAll();
+	size_t Compile(const uintptr_t objectDescId);
+	void BuildNameSlots(SerializationPlan& plan);
+	void ComputeHasPointers();
+
+	static uint32_t HashStepName(const char* name, const size_t length, const uint32_t seed);
+
+	std::vector<SerializationStep> m_steps;
+	std::vector<SerializationPlan> m_plans;
+	// Step index relative to the plan for every slot of every plan
+	std::vector<size_t> m_nameSlots;
+	std::unordered_map<uintptr_t, size_t> m_planIndices;
+	std::atomic<bool> m_isCompiled{ false };
+	std::mutex m_compileMutex;
+};
+
+#endif
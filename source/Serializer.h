@@ -70,6 +70,11 @@ public:
 	{
 	}
 
+	// Objects created for pointers during deserialization are taken from the allocator,
+	// which must outlive them. Without an allocator every object is created with new.
+	void SetObjectAllocator(ObjectAllocator* allocator) { m_objectAllocator = allocator; }
+	ObjectAllocator* GetObjectAllocator() const { return m_objectAllocator; }
+
 	virtual void Clear()
 	{
 		m_serializedPointers.clear();
@@ -83,6 +88,11 @@ protected:
 	std::set<void*> m_serializedPointers;
 
 	std::unordered_map<uintptr_t, std::vector<void*>> m_pointersToDeserialize;
+
+	// Scratch storage for accessor property values, one per serializer
+	TempStack m_tempStack;
+
+	ObjectAllocator* m_objectAllocator = nullptr;
 };
 
 #endif
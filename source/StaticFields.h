@@ -0,0 +1,79 @@
+#ifndef STATIC_FIELDS_INCLUDE
+#define STATIC_FIELDS_INCLUDE
+
+#include "ObjectFactory.h"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Field of an object known at compile time
+template<typename ObjectType, typename FieldType>
+struct StaticField
+{
+	using Type = FieldType;
+
+	const char* name;
+	FieldType ObjectType::* pointer;
+};
+
+template<typename ObjectType, typename FieldType>
+constexpr StaticField<ObjectType, FieldType> MakeStaticField(const char* name, FieldType ObjectType::* pointer)
+{
+	return StaticField<ObjectType, FieldType>{ name, pointer };
+}
+
+// Compile-time field list of an object, specialized for every type which has one:
+//
+// template<>
+// struct StaticFields<Vec3>
+// {
+//     static constexpr auto Get()
+//     {
+//         return std::make_tuple(MakeStaticField("x", &Vec3::x), MakeStaticField("y", &Vec3::y));
+//     }
+// };
+//
+// Serializers which know the type at compile time walk the list directly, and
+// RegisterStaticFields builds the ObjectDesc for everything else from the same list.
+template<typename ObjectType>
+struct StaticFields
+{
+};
+
+template<typename ObjectType, typename = void>
+struct HasStaticFields : std::false_type {};
+
+template<typename ObjectType>
+struct HasStaticFields<ObjectType, decltype((void)StaticFields<ObjectType>::Get())> : std::true_type {};
+
+template<typename Fields, typename Func, size_t... Indices>
+void ForEachStaticField(const Fields& fields, Func&& func, std::index_sequence<Indices...>)
+{
+	using Expander = int[];
+	(void)Expander{ 0, (func(std::get<Indices>(fields)), 0)... };
+}
+
+// Calls func for every field of ObjectType in declaration order
+template<typename ObjectType, typename Func>
+void ForEachStaticField(Func&& func)
+{
+	const auto fields = StaticFields<ObjectType>::Get();
+	using Fields = typename std::decay<decltype(fields)>::type;
+	ForEachStaticField(fields, std::forward<Func>(func), std::make_index_sequence<std::tuple_size<Fields>::value>());
+}
+
+// Registers the ObjectDesc of ObjectType with the properties of its field list, so
+// plans of dynamic serialization write the same bytes as the static path
+template<typename ObjectType>
+ObjectDesc& RegisterStaticFields(const std::string& objectName)
+{
+	ObjectDesc& objectDesc = class_<ObjectType>(objectName);
+	ForEachStaticField<ObjectType>([&objectDesc](const auto& field)
+	{
+		objectDesc.AddProperty(field.name, field.pointer);
+	});
+	return objectDesc;
+}
+
+#endif
@@ -1,64 +1,174 @@
 #ifndef TEMP_CONTAINER_INCLUDE
 #define TEMP_CONTAINER_INCLUDE
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Scratch storage for one value of any type. Values are placement-constructed with
+// the alignment of their type and destroyed by Reset, trivially copyable values are
+// simply copied and need no destruction.
 class TempContainer
 {
 public:
 	TempContainer()
 	{
-		Realloc(m_currentSize);
+		Realloc(m_currentSize, alignof(std::max_align_t));
 	}
 
 	~TempContainer()
 	{
-		if (m_data)
+		Reset();
+		if (m_buffer)
 		{
-			delete[] m_data;
+			delete[] m_buffer;
+			m_buffer = nullptr;
 			m_data = nullptr;
 		}
 	}
 
+	TempContainer(const TempContainer&) = delete;
+	TempContainer& operator=(const TempContainer&) = delete;
 
 	template<typename T>
-	void SetValue(const T& value)
+	typename std::decay<T>::type* SetValue(T&& value)
 	{
-		constexpr size_t valueSize = sizeof(T);
-		if (valueSize > m_currentSize)
+		using ValueType = typename std::decay<T>::type;
+
+		Reset();
+		Reserve(sizeof(ValueType), alignof(ValueType));
+
+		if (std::is_trivially_copyable<ValueType>::value)
 		{
-			Realloc(valueSize);
+			std::memcpy(m_data, &value, sizeof(ValueType));
 		}
-		std::memcpy(m_data, &value, valueSize);
+		else
+		{
+			new (m_data) ValueType(std::forward<T>(value));
+			m_destructor = DestroyValue<ValueType>;
+		}
+		return reinterpret_cast<ValueType*>(m_data);
 	}
 
-	void Reserve(const size_t size)
+	// Default constructs a value through type erased functions, see TypeInfo::constructValue
+	void* Construct(const size_t size, const size_t alignment, void (*constructor)(void*), void (*destructor)(void*))
 	{
-		if (size > m_currentSize)
+		assert(constructor);
+
+		Reset();
+		Reserve(size, alignment);
+		constructor(m_data);
+		m_destructor = destructor;
+		return m_data;
+	}
+
+	// Destroys the stored value, the memory is kept for the next one
+	void Reset()
+	{
+		if (m_destructor)
 		{
-			Realloc(size);
+			m_destructor(m_data);
+			m_destructor = nullptr;
 		}
 	}
 
-	void SetData(void* data, const size_t size)
+	void Reserve(const size_t size, const size_t alignment = alignof(std::max_align_t))
 	{
+		const bool isAligned = reinterpret_cast<uintptr_t>(m_data) % alignment == 0U;
+		if (size > m_currentSize || !isAligned)
+		{
+			Realloc(size, alignment);
+		}
+	}
+
+	// Raw bytes, treated as trivially copyable
+	void SetData(const void* data, const size_t size)
+	{
+		Reset();
 		Reserve(size);
 		std::memcpy(m_data, data, size);
 	}
 
 	void* GetData() { return m_data; }
 private:
-	void Realloc(const size_t newSize)
+	template<typename T>
+	static void DestroyValue(void* data)
+	{
+		reinterpret_cast<T*>(data)->~T();
+	}
+
+	// Only called while no value is stored
+	void Realloc(const size_t newSize, const size_t alignment)
 	{
-		if (m_data)
+		if (m_buffer)
 		{
-			delete[] m_data;
+			delete[] m_buffer;
 		}
-		m_data = new char[newSize];
+		m_buffer = new char[newSize + alignment - 1U];
+
+		const uintptr_t address = reinterpret_cast<uintptr_t>(m_buffer);
+		const uintptr_t alignedAddress = (address + alignment - 1U) / alignment * alignment;
+		m_data = m_buffer + (alignedAddress - address);
 		m_currentSize = newSize;
 	}
 
 private:
+	char* m_buffer = nullptr;
 	char* m_data = nullptr;
 	size_t m_currentSize = 256U;
+	void (*m_destructor)(void*) = nullptr;
+};
+
+// Stack of scratch containers owned by a serializer. A container taken with Push stays
+// valid until the Scope that was open at that moment ends, so accessor properties nested
+// in other accessor properties get their own storage and serializers never share it.
+class TempStack
+{
+public:
+	class Scope
+	{
+	public:
+		explicit Scope(TempStack& stack)
+			: m_stack(stack)
+			, m_depth(stack.m_depth)
+		{
+		}
+
+		~Scope()
+		{
+			m_stack.PopTo(m_depth);
+		}
+
+	private:
+		TempStack& m_stack;
+		size_t m_depth = 0U;
+	};
+
+	TempContainer& Push()
+	{
+		if (m_depth == m_containers.size())
+		{
+			m_containers.emplace_back(new TempContainer());
+		}
+		return *m_containers[m_depth++];
+	}
+
+private:
+	void PopTo(const size_t depth)
+	{
+		while (m_depth > depth)
+		{
+			m_containers[--m_depth]->Reset();
+		}
+	}
+
+	std::vector<std::unique_ptr<TempContainer>> m_containers;
+	size_t m_depth = 0U;
 };
 
 #endif
\ No newline at end of file
@@ -1,15 +1,35 @@
 #include "TypeInfo.h"
 
+#include <atomic>
+
 TypeInfoCollection& TypeInfoCollection::GetInstance()
 {
 	static TypeInfoCollection typeInfoCollection;
 	return typeInfoCollection;
 }
 
+size_t TypeInfoCollection::AllocateTypeId()
+{
+	static std::atomic<size_t> s_nextTypeId(0U);
+	return s_nextTypeId++;
+}
+
 TypeInfo* TypeInfoCollection::GetTypeInfo(const std::string& typeName)
 {
-	auto findResult = m_typeInfos.find(typeName);
-	assert(findResult != m_typeInfos.end());
+	auto findResult = m_typeInfosByName.find(typeName);
+	assert(findResult != m_typeInfosByName.end());
 
-	return &(findResult->second);
-}
\ No newline at end of file
+	return findResult->second;
+}
+
+TypeInfo* TypeInfoCollection::GetTypeInfo(const std::type_info& typeInfo)
+{
+	auto findResult = m_typeInfosByStdTypeInfo.find(&typeInfo);
+	if (findResult != m_typeInfosByStdTypeInfo.end())
+	{
+		return findResult->second;
+	}
+
+	// std::type_info objects are not guaranteed to be unique across modules
+	return GetTypeInfo(std::string(typeInfo.name()));
+}
@@ -2,14 +2,19 @@
 #define TYPE_INFO_INCLUDE
 
 #include "TypeTraits.h"
+#include "ObjectAllocator.h"
+#include "ArchiveView.h"
 
 #include <cstdint>
 #include <iostream>
 #include <memory>
-#include <functional>
 #include <cstdint>
 #include <cassert>
 #include <typeinfo>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 template<size_t index>
 using TypeId_ = std::integral_constant<size_t, index>;
@@ -51,6 +56,8 @@ REGISTER_BASIC_TYPE(uint32_t, 7, sizeof(uint32_t))
 REGISTER_BASIC_TYPE(uint64_t, 8, sizeof(uint64_t))
 REGISTER_BASIC_TYPE(float, 9, sizeof(float))
 REGISTER_BASIC_TYPE(double, 10, sizeof(double))
+REGISTER_BASIC_TYPE(bool, 11, sizeof(bool))
+REGISTER_BASIC_TYPE(char, 12, sizeof(char))
 
 enum BasicType
 {
@@ -63,22 +70,160 @@ enum BasicType
 	BT_UNSIGNED_INT_32,
 	BT_UNSIGNED_INT_64,
 	BT_FLOAT,
-	BT_DOUBLE
+	BT_DOUBLE,
+	BT_BOOL,
+	BT_CHAR,
+	BT_COUNT
 };
 
+// Integral types without an entry of their own (long long, wchar_t, ...)
+// share the entry of the fixed width type of the same size and signedness
+template<typename T>
+constexpr size_t GetBasicTypeIndex() noexcept
+{
+	if (TypeToId<T>() != 0U || !std::is_integral<T>::value)
+	{
+		return TypeToId<T>();
+	}
+
+	const size_t firstIndex = std::is_signed<T>::value ? BT_INT_8 : BT_UNSIGNED_INT_8;
+	switch (sizeof(T))
+	{
+	case 1U:
+		return firstIndex;
+	case 2U:
+		return firstIndex + 1U;
+	case 4U:
+		return firstIndex + 2U;
+	case 8U:
+		return firstIndex + 3U;
+	default:
+		return 0U;
+	}
+}
+
+template<typename T>
+std::enable_if_t<std::is_default_constructible<T>::value>
+AllocateDefaultValue(void*& data, size_t& size)
+{
+	data = reinterpret_cast<void*>(new T());
+	size = sizeof(T);
+}
+
+template<typename T>
+std::enable_if_t<!std::is_default_constructible<T>::value>
+AllocateDefaultValue(void*& data, size_t& size)
+{
+	data = nullptr;
+	size = 0U;
+}
+
+template<typename T>
+std::enable_if_t<std::is_default_constructible<T>::value>
+DeallocateValue(void* data)
+{
+	auto t = reinterpret_cast<T*>(data);
+	delete t;
+}
+
+template<typename T>
+std::enable_if_t<!std::is_default_constructible<T>::value>
+DeallocateValue(void* data)
+{
+}
+
+template<typename T>
+void ConstructObject(T* data)
+{
+	new (data) T();
+}
+
+// Static arrays are constructed and destroyed element by element
+template<typename T, size_t N>
+void ConstructObject(T (*data)[N])
+{
+	for (size_t i = 0U; i < N; ++i)
+	{
+		ConstructObject(&(*data)[i]);
+	}
+}
+
+template<typename T>
+void DestroyObject(T* data)
+{
+	data->~T();
+}
+
+template<typename T, size_t N>
+void DestroyObject(T (*data)[N])
+{
+	for (size_t i = N; i > 0U; --i)
+	{
+		DestroyObject(&(*data)[i - 1U]);
+	}
+}
+
+template<typename T>
+void ConstructValue(void* data)
+{
+	ConstructObject(reinterpret_cast<T*>(data));
+}
+
+template<typename T>
+void DestructValue(void* data)
+{
+	DestroyObject(reinterpret_cast<T*>(data));
+}
+
+template<typename T>
+std::enable_if_t<std::is_default_constructible<T>::value, ValueConstructor>
+GetValueConstructor()
+{
+	return ConstructValue<T>;
+}
+
+template<typename T>
+std::enable_if_t<!std::is_default_constructible<T>::value, ValueConstructor>
+GetValueConstructor()
+{
+	return nullptr;
+}
+
+// Nullptr for trivially destructible types, so nothing is registered for them
+template<typename T>
+ValueDestructor GetValueDestructor()
+{
+	return std::is_trivially_destructible<T>::value ? nullptr : DestructValue<T>;
+}
+
 class TypeInfo;
 
+template<typename T>
+const TypeInfo* GetTypeInfo(void* rawObject);
+
+// Defined in ObjectFactory.h
+template<typename ObjectType>
+bool IsObjectTypeRegistered();
+
+template<typename ObjectType>
+uintptr_t GetObjectTypeId();
+
 template<typename T, typename Cond = void>
 struct TypeFiller
 {
-	static void Fill(TypeInfo& typeInfo) {}
+	static void Fill(TypeInfo&) {}
 };
 
+// Every type gets a dense integer id on first use, TypeInfos are stored in a vector
+// indexed by it. Type names are only a secondary index, used by deserialization.
 class TypeInfoCollection
 {
 public:
 	static TypeInfoCollection& GetInstance();
 
+	template<typename T>
+	static size_t GetTypeId();
+
 	template<typename T>
 	TypeInfo* RegisterTypeInfo();
 
@@ -90,10 +235,23 @@ public:
 
 	TypeInfo* GetTypeInfo(const std::string& typeName);
 
+	// Lookup by the dynamic type of a polymorphic object. Does not modify the
+	// collection, so it is safe to call from several serializing threads.
+	TypeInfo* GetTypeInfo(const std::type_info& typeInfo);
+
 	template<typename T>
 	bool IsTypeInfoRegistered() const;
 private:
-	std::unordered_map <std::string, TypeInfo> m_typeInfos;
+	static size_t AllocateTypeId();
+
+	TypeInfo* FindTypeInfo(const size_t typeId) const
+	{
+		return typeId < m_typeInfos.size() ? m_typeInfos[typeId].get() : nullptr;
+	}
+
+	std::vector<std::unique_ptr<TypeInfo>> m_typeInfos;
+	std::unordered_map<std::string, TypeInfo*> m_typeInfosByName;
+	std::unordered_map<const std::type_info*, TypeInfo*> m_typeInfosByStdTypeInfo;
 };
 
 class TypeInfo
@@ -109,6 +267,7 @@ public:
 		Enum,
 		Map,
 		String,
+		View,
 
 		Undefined
 	};
@@ -122,6 +281,8 @@ public:
 		Undefined
 	};
 
+	Type type = Type::Undefined;
+
 	struct FundamentalTypeParams
 	{
 		size_t typeSize = 0U;
@@ -130,47 +291,86 @@ public:
 
 	struct ArrayParams
 	{
-		using SizeGetter = std::function<size_t(void*)>;
-		using ItemGetter = std::function<void*(void*, const size_t)>;
-		using SizeSetter = std::function<void(void*, size_t)>;
+		using SizeGetter = size_t(*)(void*);
+		using ItemGetter = void*(*)(void*, const size_t);
+		using SizeSetter = void(*)(void*, size_t);
+		using DataGetter = void*(*)(void*);
 
 		SizeGetter getSize = nullptr;
 		ItemGetter getItem = nullptr;
 		SizeSetter setSize = nullptr;
+		// Address of the first element, elements are laid out contiguously with elementSize stride
+		DataGetter getData = nullptr;
 
 		ArrayType arrayType = ArrayType::Undefined;
 		TypeInfo* elementTypeInfo = nullptr;
 		// For C-style and static arrays
 		size_t elementsCount = 0U;
+		size_t elementSize = 0U;
+		bool isTriviallyCopyable = false;
 
 	} arrayParams;
 
+	// ArchiveView, the data is an ArchiveViewData
+	struct ViewParams
+	{
+		TypeInfo* elementTypeInfo = nullptr;
+		size_t elementSize = 0U;
+
+	} viewParams;
+
 	struct MapParams
 	{
-		using SizeGetter = std::function<size_t(void*)>;
-		using IteratorGetter = std::function<void*(void*)>;
-		using KeyGetter = std::function<const void*(void*)>;
-		using ValueGetter = std::function<void*(void*)>;
-		using IteratorValidator = std::function<const bool(void*, void*)>;
-		using IteratorIncrementator = std::function<void(void*)>;
-		using KeyValueSetter = std::function<void(void*, void*, void*)>;
+		// Caller-provided storage for a map iterator, large enough for checked iterators too.
+		// Debug iterators register themselves in their container, so they are destroyed here.
+		struct IteratorStorage
+		{
+			IteratorStorage() = default;
+			IteratorStorage(const IteratorStorage&) = delete;
+			IteratorStorage& operator=(const IteratorStorage&) = delete;
+			~IteratorStorage()
+			{
+				if (destroy)
+				{
+					destroy(data);
+				}
+			}
+
+			alignas(void*) char data[8U * sizeof(void*)];
+			ValueDestructor destroy = nullptr;
+		};
+
+		using SizeGetter = size_t(*)(void*);
+		using IteratorInitializer = void(*)(void*, IteratorStorage&);
+		using KeyGetter = const void*(*)(void*);
+		using ValueGetter = void*(*)(void*);
+		using IteratorValidator = bool(*)(void*, void*);
+		using IteratorIncrementator = void(*)(void*);
+		using KeyValueSetter = void(*)(void*, void*, void*);
+		using ValueEmplacer = void*(*)(void*, void*);
+		using Clearer = void(*)(void*);
 
 		TypeInfo* keyTypeInfo = nullptr;
 		TypeInfo* valueTypeInfo = nullptr;
 
 		SizeGetter getSize = nullptr;
-		IteratorGetter getIterator = nullptr;
+		// Writes the begin iterator into the storage, iterators are never heap allocated
+		IteratorInitializer initIterator = nullptr;
 		KeyGetter getKey = nullptr;
 		ValueGetter getValue = nullptr;
 		IteratorValidator isIteratorValid = nullptr;
 		IteratorIncrementator incrementIterator = nullptr;
 		KeyValueSetter setKeyValue = nullptr;
+		// Moves the key into the map and returns the value stored for it, new values are
+		// default constructed. Map nodes do not move, so the value can be read in place.
+		ValueEmplacer emplaceValue = nullptr;
+		Clearer clear = nullptr;
 
 	} mapParams;
 
 	struct PointerParams
 	{
-		using ActualTypeInfoGetter= std::function<const TypeInfo*(void*)>;
+		using ActualTypeInfoGetter = const TypeInfo*(*)(void*);
 
 		TypeInfo* underlyingType = nullptr;
 
@@ -178,24 +378,49 @@ public:
 
 	} pointerParams;
 
-	const uintptr_t GetObjectDescId() const { return objectDescId; }
-	std::function<void(void*&, size_t&)> createDefaultValue;
-	std::function<void(void*)> deleteValue;
+	uintptr_t GetObjectDescId() const { return objectDescId; }
+	void (*createDefaultValue)(void*&, size_t&) = nullptr;
+	void (*deleteValue)(void*) = nullptr;
+
+	// Placement construction in memory provided by an allocator or a temp container
+	size_t size = 0U;
+	size_t alignment = 0U;
+	ValueConstructor constructValue = nullptr;
+	ValueDestructor destructValue = nullptr;
+
+	// Default constructed value, taken from the allocator when it is given
+	void* CreateValue(ObjectAllocator* allocator) const
+	{
+		if (allocator)
+		{
+			return allocator->Create(size, alignment, constructValue, destructValue);
+		}
+
+		void* data = nullptr;
+		size_t dataSize = 0U;
+		createDefaultValue(data, dataSize);
+		return data;
+	}
 
 	const std::string& GetName() const { return m_name; }
+	// Dense id, see TypeInfoCollection::GetTypeId
+	size_t GetId() const { return m_id; }
 
 	template<typename ObjectType>
 	void Init()
 	{
 		createDefaultValue = AllocateDefaultValue<ObjectType>;
 		deleteValue = DeallocateValue<ObjectType>;
+		size = sizeof(ObjectType);
+		alignment = alignof(ObjectType);
+		constructValue = GetValueConstructor<ObjectType>();
+		destructValue = GetValueDestructor<ObjectType>();
 
 		if (std::is_fundamental<ObjectType>::value)
 		{
 			type = Fundamental;
-			fundamentalTypeParams.typeIndex = TypeToId<ObjectType>();
-			fundamentalTypeParams.typeSize = GetTypeSize<ObjectType>();
-			
+
+			TypeFiller<ObjectType>::Fill(*this);
 		}
 		else if (std::is_enum<ObjectType>::value)
 		{
@@ -227,23 +452,29 @@ public:
 		else if (std::is_pointer<ObjectType>::value)
 		{
 			type = Pointer;
-			using RawObjectType = std::remove_pointer<ObjectType>::type;
+			using RawObjectType = typename std::remove_pointer<ObjectType>::type;
 
 			auto& typeInfoCollection = TypeInfoCollection::GetInstance();
 			if (!typeInfoCollection.IsTypeInfoRegistered<RawObjectType>())
 			{
 				pointerParams.underlyingType = typeInfoCollection.RegisterTypeInfo<RawObjectType>();
-				pointerParams.underlyingType->pointerParams.getActualTypeInfo = GetTypeInfo<RawObjectType>;
 			}
 			else
 			{
 				pointerParams.underlyingType = typeInfoCollection.GetTypeInfo<RawObjectType>();
 			}
+			// The pointed type may have been registered as a plain field type before
+			pointerParams.underlyingType->pointerParams.getActualTypeInfo = GetTypeInfo<RawObjectType>;
 		}
 		else if (is_string<ObjectType>::value)
 		{
 			type = String;
 		}
+		else if (is_archive_view<ObjectType>::value)
+		{
+			type = View;
+			TypeFiller<ObjectType>::Fill(*this);
+		}
 		
 		else if (is_map<ObjectType>::value)
 		{
@@ -252,26 +483,23 @@ public:
 		}
 		else if (std::is_class<ObjectType>::value)
 		{
-			const auto& objectFactory = ObjectFactory::GetInstance();
-			if (objectFactory.IsObjectRegistered<ObjectType>())
+			if (IsObjectTypeRegistered<ObjectType>())
 			{
 				type = Class;
-				objectDescId = objectFactory.GetObjectId<ObjectType>();
+				objectDescId = GetObjectTypeId<ObjectType>();
 			}
 		}
-
-		const std::string typeName = typeid(ObjectType).name();
 	}
 
-	Type type = Type::Undefined;
 	uintptr_t objectDescId = 0U;
+	size_t m_id = 0U;
 	std::string m_name;
 
 	friend class TypeInfoCollection;
 };
 
 template<typename T>
-const size_t VectorSizeGetter(void* data)
+size_t VectorSizeGetter(void* data)
 {
 	using VectorType = std::vector<T>;
 	auto vectorPtr = reinterpret_cast<VectorType*>(data);
@@ -296,6 +524,14 @@ void VectorSizeSetter(void* data, const size_t size)
 	(*vectorPtr).resize(size);
 }
 
+template<typename T>
+void* VectorDataGetter(void* data)
+{
+	using VectorType = std::vector<T>;
+	auto vectorPtr = reinterpret_cast<VectorType*>(data);
+	return reinterpret_cast<void*>((*vectorPtr).data());
+}
+
 
 template<typename T>
 void* ArrayItemGetter(void* data, const size_t idx)
@@ -305,6 +541,12 @@ void* ArrayItemGetter(void* data, const size_t idx)
 	return reinterpret_cast<void*>(dataPtr);
 }
 
+template<typename T>
+void* ArrayDataGetter(void* data)
+{
+	return data;
+}
+
 template<typename T, size_t N>
 void* StaticArrayItemGetter(void* data, const size_t idx)
 {
@@ -314,20 +556,42 @@ void* StaticArrayItemGetter(void* data, const size_t idx)
 	return reinterpret_cast<void*>(dataPtr);
 }
 
+template<typename T, size_t N>
+void* StaticArrayDataGetter(void* data)
+{
+	using ArrayType = std::array<T, N>;
+	auto arrayPtr = reinterpret_cast<ArrayType*>(data);
+	return reinterpret_cast<void*>((*arrayPtr).data());
+}
+
 template<typename T>
 struct TypeFiller<T, std::enable_if_t<is_vector<T>::value>>
 {
 	static void Fill(TypeInfo& typeInfo)
 	{
-		typeInfo.arrayParams.getSize = VectorSizeGetter<T>;
-		typeInfo.arrayParams.getItem = VectorItemGetter<T>;
-		typeInfo.arrayParams.setSize = VectorSizeSetter<T>;
+		using ElementType = typename remove_vector_extent<T>::type;
+		typeInfo.arrayParams.getSize = VectorSizeGetter<ElementType>;
+		typeInfo.arrayParams.getItem = VectorItemGetter<ElementType>;
+		typeInfo.arrayParams.setSize = VectorSizeSetter<ElementType>;
+		typeInfo.arrayParams.getData = VectorDataGetter<ElementType>;
+		typeInfo.arrayParams.elementSize = sizeof(ElementType);
+		typeInfo.arrayParams.isTriviallyCopyable = std::is_trivially_copyable<ElementType>::value;
 
-		using ElementType = remove_vector_extent<T>::type;
 		typeInfo.arrayParams.elementTypeInfo = TypeInfoCollection::GetInstance().GetOrRegisterTypeInfo<ElementType>();
 	}
 };
 
+template<typename T>
+struct TypeFiller<T, std::enable_if_t<is_archive_view<T>::value>>
+{
+	static void Fill(TypeInfo& typeInfo)
+	{
+		using ElementType = typename T::ValueType;
+		typeInfo.viewParams.elementSize = sizeof(ElementType);
+		typeInfo.viewParams.elementTypeInfo = TypeInfoCollection::GetInstance().GetOrRegisterTypeInfo<ElementType>();
+	}
+};
+
 template<typename T>
 struct ArraySize{};
 
@@ -348,9 +612,12 @@ struct TypeFiller<T, std::enable_if_t<is_static_array<T>::value>>
 {
 	static void Fill(TypeInfo& typeInfo)
 	{
-		using ElementType = remove_static_array_extent<T>::type;
+		using ElementType = typename remove_static_array_extent<T>::type;
 		typeInfo.arrayParams.getItem = StaticArrayItemGetter<ElementType, ArraySize<T>::size>;
+		typeInfo.arrayParams.getData = StaticArrayDataGetter<ElementType, ArraySize<T>::size>;
 		typeInfo.arrayParams.elementsCount = ArraySize<T>::size;
+		typeInfo.arrayParams.elementSize = sizeof(ElementType);
+		typeInfo.arrayParams.isTriviallyCopyable = std::is_trivially_copyable<ElementType>::value;
 
 		typeInfo.arrayParams.elementTypeInfo = TypeInfoCollection::GetInstance().GetOrRegisterTypeInfo<ElementType>();
 	}
@@ -361,9 +628,12 @@ struct TypeFiller<T, std::enable_if_t<std::is_array<T>::value>>
 {
 	static void Fill(TypeInfo& typeInfo)
 	{
-		using ElementType = std::remove_extent<T>::type;
+		using ElementType = typename std::remove_extent<T>::type;
 		typeInfo.arrayParams.getItem = ArrayItemGetter<ElementType>;
-		typeInfo.arrayParams.elementsCount = ArraySize<T>::size;	
+		typeInfo.arrayParams.getData = ArrayDataGetter<ElementType>;
+		typeInfo.arrayParams.elementsCount = ArraySize<T>::size;
+		typeInfo.arrayParams.elementSize = sizeof(ElementType);
+		typeInfo.arrayParams.isTriviallyCopyable = std::is_trivially_copyable<ElementType>::value;
 
 		typeInfo.arrayParams.elementTypeInfo = TypeInfoCollection::GetInstance().GetOrRegisterTypeInfo<ElementType>();
 	}
@@ -392,7 +662,7 @@ struct MapTypeWrapper<std::unordered_map<Key, Value>>
 };
 
 template<typename MapType>
-const size_t MapSizeGetter(void* data)
+size_t MapSizeGetter(void* data)
 {
 	auto mapPtr = reinterpret_cast<MapType*>(data);
 	const size_t size = (*mapPtr).size();
@@ -400,19 +670,21 @@ const size_t MapSizeGetter(void* data)
 }
 
 template<typename MapType>
-void* MapIteratorGetter(void* data)
+void MapIteratorInitializer(void* data, TypeInfo::MapParams::IteratorStorage& storage)
 {
+	using IteratorType = typename MapType::iterator;
+	static_assert(sizeof(IteratorType) <= sizeof(storage.data), "Map iterator does not fit into IteratorStorage");
+	static_assert(alignof(IteratorType) <= alignof(void*), "Map iterator is overaligned for IteratorStorage");
+
 	auto mapPtr = reinterpret_cast<MapType*>(data);
-	auto it = (*mapPtr).begin();
-	auto t = new decltype(it);
-	(*t) = it;
-	return t;
+	new (storage.data) IteratorType((*mapPtr).begin());
+	storage.destroy = GetValueDestructor<IteratorType>();
 }
 
 template<typename MapType>
 const void* MapKeyGetter(void* data)
 {
-	using IteratorType = MapType::iterator;
+	using IteratorType = typename MapType::iterator;
 
 	IteratorType* itPtr = reinterpret_cast<IteratorType*>(data);
 	auto keyPtr = &((*itPtr)->first);
@@ -424,7 +696,7 @@ const void* MapKeyGetter(void* data)
 template<typename MapType>
 void* MapValueGetter(void* data)
 {
-	using IteratorType = MapType::iterator;
+	using IteratorType = typename MapType::iterator;
 
 	IteratorType* itPtr = reinterpret_cast<IteratorType*>(data);
 	auto valuePtr = &((*itPtr)->second);
@@ -434,9 +706,9 @@ void* MapValueGetter(void* data)
 }
 
 template<typename MapType>
-const bool MapIteratorValidator(void* iteratorRawPtr, void* mapRawPtr)
+bool MapIteratorValidator(void* iteratorRawPtr, void* mapRawPtr)
 {
-	using IteratorType = MapType::iterator;
+	using IteratorType = typename MapType::iterator;
 
 	auto mapPtr = reinterpret_cast<MapType*>(mapRawPtr);
 	auto itPtr = reinterpret_cast<IteratorType*>(iteratorRawPtr);
@@ -448,7 +720,7 @@ const bool MapIteratorValidator(void* iteratorRawPtr, void* mapRawPtr)
 template<typename MapType>
 void MapIteratorIncrementator(void* iteratorRawPtr)
 {
-	using IteratorType = MapType::iterator;
+	using IteratorType = typename MapType::iterator;
 	auto itPtr = reinterpret_cast<IteratorType*>(iteratorRawPtr);
 	++(*itPtr);
 }
@@ -463,23 +735,39 @@ void MapKeyValueSetter(void* map, void* key, void* value)
 	(*mapPtr)[(*keyPtr)] = (*valuePtr);
 }
 
+template<typename MapType, typename KeyType>
+void* MapValueEmplacer(void* map, void* key)
+{
+	auto mapPtr = reinterpret_cast<MapType*>(map);
+	auto keyPtr = reinterpret_cast<KeyType*>(key);
+
+	return &(*mapPtr)[std::move(*keyPtr)];
+}
+
+template<typename MapType>
+void MapClearer(void* map)
+{
+	reinterpret_cast<MapType*>(map)->clear();
+}
 
 template<typename T>
 struct TypeFiller<T, std::enable_if_t<is_map<T>::value>>
 {
 	static void Fill(TypeInfo& typeInfo)
 	{
-		using MapType = MapTypeWrapper<T>::MapType;
-		using KeyType = MapTypeWrapper<T>::KeyType;
-		using ValueType = MapTypeWrapper<T>::ValueType;
+		using MapType = typename MapTypeWrapper<T>::MapType;
+		using KeyType = typename MapTypeWrapper<T>::KeyType;
+		using ValueType = typename MapTypeWrapper<T>::ValueType;
 		
 		typeInfo.mapParams.getSize = MapSizeGetter<MapType>;
-		typeInfo.mapParams.getIterator = MapIteratorGetter<MapType>;
+		typeInfo.mapParams.initIterator = MapIteratorInitializer<MapType>;
 		typeInfo.mapParams.getKey = MapKeyGetter<MapType>;
 		typeInfo.mapParams.getValue = MapValueGetter<MapType>;
 		typeInfo.mapParams.isIteratorValid = MapIteratorValidator<MapType>;
 		typeInfo.mapParams.incrementIterator = MapIteratorIncrementator<MapType>;
 		typeInfo.mapParams.setKeyValue = MapKeyValueSetter<MapType, KeyType, ValueType>;
+		typeInfo.mapParams.emplaceValue = MapValueEmplacer<MapType, KeyType>;
+		typeInfo.mapParams.clear = MapClearer<MapType>;
 
 		auto& typeInfoCollection = TypeInfoCollection::GetInstance();
 		typeInfo.mapParams.keyTypeInfo = typeInfoCollection.GetOrRegisterTypeInfo<KeyType>();
@@ -488,53 +776,59 @@ struct TypeFiller<T, std::enable_if_t<is_map<T>::value>>
 };
 
 template<typename T>
-struct TypeFiller<T, std::enable_if_t<std::is_enum<T>::value>>
+struct TypeFiller<T, std::enable_if_t<std::is_fundamental<T>::value>>
 {
 	static void Fill(TypeInfo& typeInfo)
 	{
-		using UnderlyingType = std::underlying_type<T>::type;
-		typeInfo.fundamentalTypeParams.typeIndex = TypeToId<UnderlyingType>();
-		typeInfo.fundamentalTypeParams.typeSize = GetTypeSize<UnderlyingType>();
+		typeInfo.fundamentalTypeParams.typeIndex = GetBasicTypeIndex<T>();
+		typeInfo.fundamentalTypeParams.typeSize = sizeof(T);
 	}
 };
 
 template<typename T>
-std::enable_if_t<std::is_default_constructible<T>::value>
-AllocateDefaultValue(void*& data, size_t& size)
-{
-	data = reinterpret_cast<void*>(new T());
-	size = sizeof(T);
-}
-
-template<typename T>
-std::enable_if_t<!std::is_default_constructible<T>::value>
-AllocateDefaultValue(void*& data, size_t& size)
+struct TypeFiller<T, std::enable_if_t<std::is_enum<T>::value>>
 {
-	data = nullptr;
-	size = 0U;
-}
+	static void Fill(TypeInfo& typeInfo)
+	{
+		using UnderlyingType = typename std::underlying_type<T>::type;
+		typeInfo.fundamentalTypeParams.typeIndex = GetBasicTypeIndex<UnderlyingType>();
+		typeInfo.fundamentalTypeParams.typeSize = sizeof(UnderlyingType);
+	}
+};
 
 template<typename T>
-std::enable_if_t<std::is_default_constructible<T>::value>
-DeallocateValue(void* data)
+size_t TypeInfoCollection::GetTypeId()
 {
-	auto t = reinterpret_cast<T*>(data);
-	delete t;
-}
+	// typeid ignores references and cv-qualifiers, so do the ids
+	using BaseType = typename std::remove_cv<typename std::remove_reference<T>::type>::type;
+	if (!std::is_same<T, BaseType>::value)
+	{
+		return GetTypeId<BaseType>();
+	}
 
-template<typename T>
-std::enable_if_t<!std::is_default_constructible<T>::value>
-DeallocateValue(void* data)
-{
+	static const size_t typeId = AllocateTypeId();
+	return typeId;
 }
 
 template<typename T>
 TypeInfo* TypeInfoCollection::RegisterTypeInfo()
 {
-	const auto typeName = typeid(T).name();
-	auto& typeInfo = m_typeInfos[typeName];
+	const auto typeId = GetTypeId<T>();
+	if (typeId >= m_typeInfos.size())
+	{
+		m_typeInfos.resize(typeId + 1U);
+	}
+	assert(!m_typeInfos[typeId]);
+
+	// Stored before Init so types referring to themselves find it
+	m_typeInfos[typeId].reset(new TypeInfo());
+	TypeInfo& typeInfo = *m_typeInfos[typeId];
+	typeInfo.m_id = typeId;
+	typeInfo.m_name = typeid(T).name();
+	m_typeInfosByName[typeInfo.m_name] = &typeInfo;
+	m_typeInfosByStdTypeInfo[&typeid(T)] = &typeInfo;
+
 	typeInfo.Init<T>();
-	typeInfo.m_name = typeName;
 
 	return &typeInfo;
 }
@@ -542,46 +836,34 @@ TypeInfo* TypeInfoCollection::RegisterTypeInfo()
 template<typename T>
 TypeInfo* TypeInfoCollection::GetTypeInfo()
 {
-	const auto typeName = typeid(T).name();
-	auto findResult = m_typeInfos.find(typeName);
-	assert(findResult != m_typeInfos.end());
+	auto typeInfo = FindTypeInfo(GetTypeId<T>());
+	assert(typeInfo != nullptr);
 
-	return &(findResult->second);
+	return typeInfo;
 }
 
 template<typename T>
 TypeInfo* TypeInfoCollection::GetOrRegisterTypeInfo()
 {
-	const auto typeName = typeid(T).name();
-	auto findResult = m_typeInfos.find(typeName);
-	if (findResult != m_typeInfos.end())
+	auto typeInfo = FindTypeInfo(GetTypeId<T>());
+	if (typeInfo != nullptr)
 	{
-		return &(findResult->second);
-	}
-	else
-	{
-		auto& typeInfo = m_typeInfos[typeName];
-		typeInfo.Init<T>();
-		typeInfo.m_name = typeName;
-
-		return &typeInfo;
+		return typeInfo;
 	}
+	return RegisterTypeInfo<T>();
 }
 
 template<typename T>
 bool TypeInfoCollection::IsTypeInfoRegistered() const
 {
-	const auto typeName = typeid(T).name();
-	auto findResult = m_typeInfos.find(typeName);
-	return findResult != m_typeInfos.end();
+	return FindTypeInfo(GetTypeId<T>()) != nullptr;
 }
 
 template<typename T>
-TypeInfo* GetTypeInfo(void* rawObject)
+const TypeInfo* GetTypeInfo(void* rawObject)
 {
 	T* object = reinterpret_cast<T*>(rawObject);
-	const std::string typeName = typeid(*object).name();
-	return TypeInfoCollection::GetInstance().GetTypeInfo(typeName);
+	return TypeInfoCollection::GetInstance().GetTypeInfo(typeid(*object));
 }
 
 #endif // !TYPE_INFO_INCLUDE
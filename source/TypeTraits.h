@@ -2,6 +2,9 @@
 #define TYPE_TRAITS_INCLUDE
 
 #include <type_traits>
+#include <algorithm>
+#include <utility>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <array>
@@ -53,6 +56,25 @@ struct is_map<std::unordered_map<KeyType, ValueType>> : std::true_type {};
 template<typename KeyType, typename ValueType>
 struct is_map<const std::unordered_map<KeyType, ValueType>> : std::true_type {};
 
+template<typename T>
+class ArchiveView;
+
+template<typename T>
+struct is_archive_view : std::false_type {};
+
+template<typename T>
+struct is_archive_view<ArchiveView<T>> : std::true_type {};
+
+template<typename T>
+struct is_archive_view<const ArchiveView<T>> : std::true_type {};
+
+// Downcasts from virtual bases are ill-formed, which tells them from ordinary bases
+template<typename BaseType, typename DerivedType, typename = void>
+struct is_virtual_base_of : std::is_base_of<BaseType, DerivedType> {};
+
+template<typename BaseType, typename DerivedType>
+struct is_virtual_base_of<BaseType, DerivedType, decltype((void)static_cast<DerivedType*>(std::declval<BaseType*>()))> : std::false_type {};
+
 template<typename T>
 struct remove_vector_extent { using type = T; };
 
@@ -115,7 +137,22 @@ struct MemberAssigner<ClassField<ObjectType, FieldType>>
 	void operator()(void* object, void* data)
 	{
 		ObjectType* concreteObject = reinterpret_cast<ObjectType*>(object);
-		concreteObject->*fieldPtr = *(reinterpret_cast<FieldType*>(data));
+		FieldType* value = reinterpret_cast<FieldType*>(data);
+		// Serializers decode direct fields in place, copying them onto themselves is wasted work
+		if (&(concreteObject->*fieldPtr) != value)
+		{
+			concreteObject->*fieldPtr = *value;
+		}
+	}
+
+	void Move(void* object, void* data)
+	{
+		ObjectType* concreteObject = reinterpret_cast<ObjectType*>(object);
+		FieldType* value = reinterpret_cast<FieldType*>(data);
+		if (&(concreteObject->*fieldPtr) != value)
+		{
+			concreteObject->*fieldPtr = std::move(*value);
+		}
 	}
 
 	ConcreteClassField fieldPtr = nullptr;
@@ -130,16 +167,53 @@ struct MemberAssigner<ClassField<ObjectType, FieldType[N]>>
 	{
 	}
 
+	// Nested arrays are assigned as one flat array of their innermost elements
+	using ElementType = typename std::remove_all_extents<FieldType>::type;
+	static constexpr size_t ElementsCount = sizeof(FieldType[N]) / sizeof(ElementType);
+
 	void operator()(void* object, void* data)
+	{
+		Assign(object, data, std::is_trivially_copyable<ElementType>(), false);
+	}
+
+	void Move(void* object, void* data)
+	{
+		Assign(object, data, std::is_trivially_copyable<ElementType>(), true);
+	}
+
+	ConcreteClassField fieldPtr = nullptr;
+
+private:
+	void Assign(void* object, void* data, std::true_type, const bool)
 	{
 		ObjectType* concreteObject = reinterpret_cast<ObjectType*>(object);
 
 		void* dstPtr = reinterpret_cast<void*>(concreteObject->*fieldPtr);
-
-		std::memcpy(dstPtr, data, N);
+		if (dstPtr != data)
+		{
+			std::memcpy(dstPtr, data, sizeof(FieldType[N]));
+		}
 	}
 
-	ConcreteClassField fieldPtr = nullptr;
+	void Assign(void* object, void* data, std::false_type, const bool isMove)
+	{
+		ObjectType* concreteObject = reinterpret_cast<ObjectType*>(object);
+
+		ElementType* dstPtr = reinterpret_cast<ElementType*>(concreteObject->*fieldPtr);
+		ElementType* srcPtr = reinterpret_cast<ElementType*>(data);
+		if (dstPtr == srcPtr)
+		{
+			return;
+		}
+		if (isMove)
+		{
+			std::move(srcPtr, srcPtr + ElementsCount, dstPtr);
+		}
+		else
+		{
+			std::copy(srcPtr, srcPtr + ElementsCount, dstPtr);
+		}
+	}
 };
 
 /*template<typename ObjectType, typename FieldType>